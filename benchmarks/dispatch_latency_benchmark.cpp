@@ -0,0 +1,82 @@
+/**
+ * @brief Enqueue-to-start latency benchmark for ThreadManager workers
+ *
+ * Posts single tasks separated by idle gaps (so workers go back to
+ * waiting between tasks) and reports p50/p99/p999 of the time between
+ * post() and the task starting on a worker, for each WaitStrategy:
+ * - blocking: park on the condition variable immediately
+ * - fixed spin: always spin the full budget before parking
+ * - adaptive: default spin-then-yield-then-park with adaptive budget
+ *
+ * Usage: robotact_dispatch_latency_benchmark [samples] [gap_us]
+ */
+
+#include "core/utils/thread/thread_manager.hpp"
+#include "core/utils/logger/logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace RoboTact;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+	double percentile(const std::vector<double>& sorted, double p)
+	{
+		if (sorted.empty()) return 0.0;
+		const auto index = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1));
+		return sorted[index];
+	}
+
+	void run(const char* name, Core::ThreadManager::WaitStrategy strategy,
+			 std::size_t samples, std::chrono::microseconds gap)
+	{
+		Core::ThreadManager thread_manager;
+		thread_manager.set_wait_strategy(strategy);
+
+		std::vector<double> latencies_us(samples);
+		std::atomic<std::size_t> done {0};
+
+		for (std::size_t i = 0; i < samples; ++i)
+		{
+			// Vary the gap a little so the adaptive budget sees both short and long idles
+			std::this_thread::sleep_for(gap * static_cast<long>(1 + i % 4));
+
+			const auto enqueued = Clock::now();
+			thread_manager.post([&latencies_us, &done, enqueued, i]() {
+				latencies_us[i] = std::chrono::duration<double, std::micro>(Clock::now() - enqueued).count();
+				done.fetch_add(1, std::memory_order_release);
+			});
+
+			while (done.load(std::memory_order_acquire) <= i) std::this_thread::yield();
+		}
+
+		std::sort(latencies_us.begin(), latencies_us.end());
+		std::printf("%-12s p50 %9.2f us   p99 %9.2f us   p999 %9.2f us   max %9.2f us\n", name,
+					percentile(latencies_us, 0.50), percentile(latencies_us, 0.99),
+					percentile(latencies_us, 0.999), latencies_us.empty() ? 0.0 : latencies_us.back());
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const std::size_t samples = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000;
+	const std::chrono::microseconds gap(argc > 2 ? std::strtoll(argv[2], nullptr, 10) : 50);
+
+	Core::ServiceLocator::register_service<Core::ILogger>(std::make_shared<Core::NullLogger>());
+
+	std::printf("%zu samples, idle gap %lld-%lld us, %u hardware threads\n\n", samples,
+				static_cast<long long>(gap.count()), static_cast<long long>(gap.count() * 4),
+				std::thread::hardware_concurrency());
+
+	run("blocking", { 0, 0, false }, samples, gap);
+	run("fixed spin", { Core::ThreadManager::WaitStrategy{}.max_spin, 0, false }, samples, gap);
+	run("adaptive", Core::ThreadManager::WaitStrategy{}, samples, gap);
+	return 0;
+}
@@ -0,0 +1,64 @@
+/**
+ * @brief Cost of one PROFILE_SCOPE zone
+ *
+ * Times a loop of empty nested zones with capture inactive (flag check
+ * only) and active (two clock reads plus one ring write), and writes the
+ * captured zones to a Chrome trace. Build with ROBOTACT_ENABLE_PROFILER=ON;
+ * otherwise the zones compile to nothing and both rows measure the loop.
+ *
+ * Usage: robotact_profiler_zone_benchmark [iterations] [trace.json]
+ */
+
+#include "core/utils/profiler/profiler.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+
+using namespace RoboTact;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+	double run(std::size_t iterations)
+	{
+		const auto start = Clock::now();
+		for (std::size_t i = 0; i < iterations; ++i)
+		{
+			PROFILE_SCOPE("outer");
+			{
+				PROFILE_SCOPE("inner");
+			}
+		}
+		const double total_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+		return total_ns / static_cast<double>(iterations * 2);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+	const char* trace_path = argc > 2 ? argv[2] : nullptr;
+
+	std::printf("profiler %s, %zu iterations of 2 zones\n\n",
+				Core::Profiler::is_enabled() ? "compiled in" : "compiled out", iterations);
+
+	std::printf("%-10s %8.2f ns/zone\n", "inactive", run(iterations));
+
+	Core::Profiler::start();
+	std::printf("%-10s %8.2f ns/zone\n", "active", run(iterations));
+	Core::Profiler::stop();
+
+	if (trace_path)
+	{
+		try {
+			const std::size_t zones = Core::Profiler::write_chrome_trace(trace_path);
+			std::printf("\n%zu zones written to %s\n", zones, trace_path);
+		} catch (const std::exception& e) {
+			std::fprintf(stderr, "%s\n", e.what());
+			return 1;
+		}
+	}
+	return 0;
+}
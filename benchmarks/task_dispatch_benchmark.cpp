@@ -0,0 +1,164 @@
+/**
+ * @brief Micro-benchmark for the ThreadManager task dispatch path
+ *
+ * Compares heap allocations and cost per task for:
+ * - the legacy std::function + make_shared<packaged_task> + std::bind wrapping
+ * - TaskFunction + TaskFuture (ThreadManager::submit)
+ * - TaskFunction alone (ThreadManager::post)
+ * and then runs the same three shapes end-to-end through a ThreadManager.
+ *
+ * Usage: robotact_task_dispatch_benchmark [task_count]
+ */
+
+#include "core/utils/thread/thread_manager.hpp"
+#include "core/utils/logger/logger.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <future>
+#include <new>
+#include <string>
+
+namespace
+{
+	std::atomic<std::size_t> g_allocations {0};
+}
+
+void* operator new(std::size_t size)
+{
+	g_allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* p = std::malloc(size ? size : 1)) return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+using namespace RoboTact;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+	struct Result
+	{
+		double ns_per_task;
+		double allocs_per_task;
+	};
+
+	template<typename Body>
+	Result measure(std::size_t count, Body&& body)
+	{
+		const std::size_t allocs_before = g_allocations.load();
+		const auto start = Clock::now();
+
+		body();
+
+		const auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start);
+		const std::size_t allocs = g_allocations.load() - allocs_before;
+		return { elapsed.count() / static_cast<double>(count),
+				 static_cast<double>(allocs) / static_cast<double>(count) };
+	}
+
+	void report(const char* name, const Result& r)
+	{
+		std::printf("%-34s %10.1f ns/task %8.2f allocs/task\n", name, r.ns_per_task, r.allocs_per_task);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+
+	Core::ServiceLocator::register_service<Core::ILogger>(std::make_shared<Core::NullLogger>());
+
+	// Capture roughly the size of a typical robot/sensor update closure
+	struct Payload { double pose[4]; int id; };
+	const Payload payload{ {1.0, 2.0, 3.0, 4.0}, 7 };
+	std::atomic<long long> sink {0};
+
+	std::printf("TaskFunction inline size: %zu bytes, %zu tasks\n\n", Core::TaskFunction::INLINE_SIZE, count);
+	std::printf("-- wrap + invoke (single thread) --\n");
+
+	report("legacy std::function/packaged_task", measure(count, [&] {
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			auto task = std::make_shared<std::packaged_task<int()>>(
+				std::bind([payload](std::size_t n) { return payload.id + static_cast<int>(n); }, i));
+			std::future<int> res = task->get_future();
+			std::function<void()> queued([task]() { (*task)(); });
+			queued();
+			sink += res.get();
+		}
+	}));
+
+	report("TaskFunction + TaskFuture", measure(count, [&] {
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			auto bound = [payload, i]() { return payload.id + static_cast<int>(i); };
+			using State = Core::detail::PackagedTaskState<int, decltype(bound)>;
+			auto* state = new State(std::move(bound));
+			state->add_ref();
+			Core::TaskFuture<int> res(state);
+			Core::TaskFunction queued{Core::detail::PackagedTaskRunner<int, decltype(bound)>(state)};
+			queued();
+			sink += res.get();
+		}
+	}));
+
+	report("TaskFunction (post)", measure(count, [&] {
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			Core::TaskFunction queued([payload, i, &sink]() { sink += payload.id + static_cast<int>(i); });
+			queued();
+		}
+	}));
+
+	std::printf("\n-- end-to-end through ThreadManager --\n");
+	{
+		Core::ThreadManager thread_manager;
+
+		// Warm the per-worker rings so growth is not attributed to a variant
+		for (std::size_t i = 0; i < count; ++i) thread_manager.post([] {});
+		thread_manager.submit([] {}).get();
+
+		std::vector<std::future<int>> std_futures;
+		std_futures.reserve(count);
+		report("enqueue_task (std::future)", measure(count, [&] {
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				std_futures.push_back(thread_manager.enqueue_task(
+					[payload](std::size_t n) { return payload.id + static_cast<int>(n); }, i));
+			}
+			for (auto& f : std_futures) sink += f.get();
+		}));
+
+		std::vector<Core::TaskFuture<int>> task_futures;
+		task_futures.reserve(count);
+		report("submit (TaskFuture)", measure(count, [&] {
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				task_futures.push_back(thread_manager.submit(
+					[payload](std::size_t n) { return payload.id + static_cast<int>(n); }, i));
+			}
+			for (auto& f : task_futures) sink += f.get();
+		}));
+
+		std::atomic<std::size_t> done {0};
+		report("post (fire-and-forget)", measure(count, [&] {
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				thread_manager.post([payload, i, &sink, &done]() {
+					sink += payload.id + static_cast<int>(i);
+					done.fetch_add(1, std::memory_order_release);
+				});
+			}
+			while (done.load(std::memory_order_acquire) < count) std::this_thread::yield();
+		}));
+	}
+
+	std::printf("\n(checksum %lld)\n", sink.load());
+	return 0;
+}
@@ -1,7 +1,13 @@
 #include "application.hpp"
 #include "core/utils/logger/logger.hpp"
+#include "core/utils/logger/segmented_file_sink.hpp"
 #include "core/utils/timer/timer.hpp"
 #include "core/utils/service_locator/service_locator.hpp"
+#include "core/utils/memory/scratch_arena.hpp"
+#include "core/utils/profiler/profiler.hpp"
+
+#include <cstdlib>
+#include <string_view>
 
 namespace RoboTact
 {
@@ -17,7 +23,24 @@ Application::Application()
 Application::~Application()
 {
 	request_stop();
+
+	if (!m_profile_path.empty())
+	{
+		Core::Profiler::stop();
+		try {
+			const std::size_t zones = Core::Profiler::write_chrome_trace(m_profile_path);
+			LOG_INFO("Wrote", zones, "profiler zones to", m_profile_path);
+		} catch (const std::exception& e) {
+			LOG_ERROR("Profiler export failed:", e.what());
+		}
+	}
+
 	LOG_INFO("Application destroyed.");
+	Core::BinaryLog::close();
+
+	auto logger = Core::ServiceLocator::resolve<Core::ILogger>();
+	Core::flush_log_repeats(*logger);
+	logger->flush();
 }	
 
 bool Application::should_continue() const noexcept
@@ -29,16 +52,77 @@ bool Application::should_continue() const noexcept
 
 void Application::initialize_services()
 {
-    auto timer = std::make_shared<Core::Timer>();
+    // ROBOTACT_DETERMINISTIC=1 runs everything on the main thread against a
+    // virtual clock, so a run can be reproduced exactly
+    const char* deterministic = std::getenv("ROBOTACT_DETERMINISTIC");
+    Core::ThreadManager::PoolConfig pool_config;
+    if (deterministic && std::string_view(deterministic) != "0")
+    {
+        pool_config.mode = Core::ThreadManager::ExecutionMode::DETERMINISTIC;
+    }
+
+    std::shared_ptr<Core::ITimer> timer;
+    if (pool_config.mode == Core::ThreadManager::ExecutionMode::DETERMINISTIC)
+    {
+        timer = std::make_shared<Core::FixedStepTimer>(1.0 / 60.0);
+    }
+    else
+    {
+        timer = std::make_shared<Core::Timer>();
+    }
     timer->reset();
 
     auto logger = std::make_shared<Core::Logger>();
-    logger->init("application.log", Core::LogLevel::TRACE);
+    logger->set_log_level(Core::LogLevel::TRACE);
 
-    auto thread_manager = std::make_shared<Core::ThreadManager>();
+    // Full detail goes to the file; the terminal only gets INFO and up
+    Core::LogSinkConfig console_config;
+    console_config.level = Core::LogLevel::INFO;
+    logger->add_sink(std::make_shared<Core::ConsoleSink>(console_config));
+
+    // logs/application.<n>.log, rotated hourly or at 16 MiB, at most 8 kept
+    auto log_files = std::make_shared<Core::SegmentedFileSink>();
+    logger->add_sink(log_files);
+
+    // Recent lines kept in memory for an in-app log console
+    auto log_console = std::make_shared<Core::RingBufferSink>(2048);
+    logger->add_sink(log_console);
+    Core::ServiceLocator::register_service<Core::RingBufferSink>(log_console);
+    // Keeps console/file I/O off the simulation and IO loops
+    logger->start_async();
+
+    // ROBOTACT_BINARY_LOG=<file> captures LOG_* calls in binary form
+    // (decode with robotact-logdecode), e.g. when chasing control bugs
+    if (const char* binary_log = std::getenv("ROBOTACT_BINARY_LOG"); binary_log && *binary_log)
+    {
+        Core::BinaryLog::open(binary_log);
+    }
 
     Core::ServiceLocator::register_service<Core::ITimer>(timer);
     Core::ServiceLocator::register_service<Core::ILogger>(logger);
+
+    if (log_files->recovered_segments() > 0)
+    {
+        LOG_WARNING("Recovered", log_files->recovered_segments(), "log segment(s) after an unclean shutdown");
+    }
+
+    // ROBOTACT_PROFILE=<file> records PROFILE_SCOPE zones and writes them as
+    // a Chrome trace (chrome://tracing, ui.perfetto.dev) at shutdown
+    if (const char* profile = std::getenv("ROBOTACT_PROFILE"); profile && *profile)
+    {
+        if (Core::Profiler::is_enabled())
+        {
+            m_profile_path = profile;
+            Core::Profiler::start();
+        }
+        else
+        {
+            LOG_WARNING("ROBOTACT_PROFILE is set, but this build has no profiler (ROBOTACT_ENABLE_PROFILER=OFF)");
+        }
+    }
+
+    // Logs its pool layout, so the logger must be registered first
+    auto thread_manager = std::make_shared<Core::ThreadManager>(pool_config);
     Core::ServiceLocator::register_service<Core::ThreadManager>(thread_manager);
 }
 
@@ -49,14 +133,38 @@ void Application::run()
     
     auto thread_manager = Core::ServiceLocator::resolve<Core::ThreadManager>();
 
+    // Keep the dedicated loops on the cores the worker pool left free
+    const auto& reserved_cpus = thread_manager->reserved_cpus();
+    if (reserved_cpus.size() >= 2)
+    {
+        Core::ThreadSchedulingConfig simulation_placement;
+        simulation_placement.cpus = { reserved_cpus[0] };
+        thread_manager->configure_thread_type(Core::ThreadManager::ThreadType::SIMULATION, simulation_placement);
+
+        Core::ThreadSchedulingConfig io_placement;
+        io_placement.cpus = { reserved_cpus[1] };
+        thread_manager->configure_thread_type(Core::ThreadManager::ThreadType::IO, io_placement);
+    }
+
 	// Start threads through the thread manager
-    thread_manager->start_thread(
+    Core::PeriodicConfig simulation_config;
+    simulation_config.period = std::chrono::nanoseconds(1'000'000'000 / 60);  // 60 Hz simulation
+    simulation_config.spin_window = std::chrono::microseconds(100);
+    simulation_config.overrun_policy = Core::OverrunPolicy::CATCH_UP;
+
+    thread_manager->start_periodic_thread(
         Core::ThreadManager::ThreadType::SIMULATION,
+        simulation_config,
         std::bind(&Application::simulation_loop, this)
     );
-    
-    thread_manager->start_thread(
+
+    Core::PeriodicConfig io_config;
+    io_config.period = std::chrono::milliseconds(10);  // Higher frequency IO polling (100 Hz)
+    io_config.overrun_policy = Core::OverrunPolicy::SKIP;
+
+    thread_manager->start_periodic_thread(
         Core::ThreadManager::ThreadType::IO,
+        io_config,
         std::bind(&Application::io_loop, this)
     );
 
@@ -76,15 +184,31 @@ void Application::request_stop()
 void Application::main_loop()
 {
     LOG_INFO("Main thread started.");
+    PROFILE_THREAD("MAIN");
 
 	auto timer = Core::ServiceLocator::resolve<Core::ITimer>();
+    auto thread_manager = Core::ServiceLocator::resolve<Core::ThreadManager>();
+
+    // Frame target and the part of it kept free for swap_buffers
+    const auto frame_budget = std::chrono::nanoseconds(1'000'000'000 / 60);
+    const auto idle_margin = std::chrono::milliseconds(1);
 
     while (should_continue())
     {
+        PROFILE_SCOPE("frame");
+
+        // Per-frame scratch memory, released when the frame ends
+        Core::ScratchArena::Scope frame_scratch;
+
+        const auto frame_start = std::chrono::steady_clock::now();
+
 		timer->update();
 		double delta_time = timer->get_delta_time();
 
-		m_window->poll_events();
+		{
+			PROFILE_SCOPE("poll_events");
+			m_window->poll_events();
+		}
 
         double fixed_timestep = 1.0 / 60.0;
         while (timer->get_accumulated_time() >= fixed_timestep) 
@@ -93,6 +217,23 @@ void Application::main_loop()
             timer->consume_accumulated_time(fixed_timestep);
         }
 
+        // Deterministic mode: the simulation/IO ticks and queued tasks of
+        // this frame run here, in a fixed order
+        {
+            PROFILE_SCOPE("step_deterministic");
+            thread_manager->step_deterministic(frame_budget);
+        }
+
+        // Spend the measured slack of this frame on idle-lane work (every
+        // frame in deterministic mode, where the budget is ignored)
+        const auto slack = frame_budget - idle_margin - (std::chrono::steady_clock::now() - frame_start);
+        if (slack > std::chrono::nanoseconds::zero() || thread_manager->is_deterministic())
+        {
+            PROFILE_SCOPE("idle_tasks");
+            thread_manager->run_idle_tasks(slack);
+        }
+
+        PROFILE_SCOPE("swap_buffers");
         m_window->swap_buffers();
     }
     LOG_INFO("Main thread exiting.");
@@ -100,25 +241,16 @@ void Application::main_loop()
 
 void Application::simulation_loop()
 {
-    LOG_INFO("Simulation thread started.");
-    while (should_continue())
-    {
-
-        // Approx 60 Hz simulation update rate
-        std::this_thread::sleep_for(std::chrono::milliseconds(16));
-    }   
-    LOG_INFO("Simulation thread exiting.");
+    // One fixed 60 Hz simulation step; pacing is done by the PeriodicRunner
+    PROFILE_SCOPE("simulation_step");
 }
 
 void Application::io_loop()
 {
-    LOG_INFO("IO thread started.");
-    while (should_continue())
-    {
-        // Higher frequency IO polling (100 Hz)
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    }
-    LOG_INFO("IO thread exiting.");
+    // One 100 Hz IO poll; pacing is done by the PeriodicRunner
+    PROFILE_SCOPE("io_poll");
+    auto thread_manager = Core::ServiceLocator::resolve<Core::ThreadManager>();
+    thread_manager->log_stats_if_due(std::chrono::seconds(10));
 }
 
 } // namespace RoboTact
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "core/utils/thread/thread_manager.hpp"
 
 #include <memory>
+#include <string>
 
 namespace RoboTact
 {
@@ -23,11 +24,14 @@ namespace RoboTact
 
 	private:
 		void main_loop();
+
+		// Per-period bodies of the simulation/IO threads (driven by PeriodicRunner)
 		void simulation_loop();
 		void io_loop();
 		bool should_continue() const noexcept;
 
 		std::unique_ptr<Core::SDLWindow> m_window;
+		std::string m_profile_path;		///< Chrome trace written at shutdown (ROBOTACT_PROFILE)
 	};
 } // namespace RoboTact
 
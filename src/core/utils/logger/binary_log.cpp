@@ -0,0 +1,421 @@
+#include "binary_log.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace RoboTact::Core
+{
+
+namespace
+{
+    constexpr char MAGIC[8] = { 'R', 'T', 'B', 'L', 'O', 'G', '1', '\0' };
+    constexpr char SITE_RECORD = 'S';
+    constexpr char MESSAGE_RECORD = 'M';
+
+    // Thread buffers are handed to the file once they reach this size
+    constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+
+    // 'M' + u32 payload length; the payload starts with site id and time
+    constexpr std::size_t MESSAGE_HEADER_SIZE = 1 + sizeof(std::uint32_t);
+
+    struct SiteInfo
+    {
+        LogLevel level;
+        std::string file;
+        std::int32_t line;
+        std::string signature;
+    };
+
+    struct State
+    {
+        std::mutex mutex;                                   ///< Guards everything below
+        std::ofstream file;
+        std::vector<SiteInfo> sites;
+        std::vector<detail::BinaryLogBuffer*> buffers;
+        std::atomic<bool> active                {false};
+    };
+
+    State& state()
+    {
+        static State instance;
+        return instance;
+    }
+
+    template<typename T>
+    void append_value(std::string& out, T value)
+    {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void append_text(std::string& out, std::string_view text)
+    {
+        append_value(out, static_cast<std::uint32_t>(text.size()));
+        out.append(text);
+    }
+
+    // Caller holds State::mutex
+    void write_site(State& st, std::uint32_t id, const SiteInfo& site)
+    {
+        std::string record(1, SITE_RECORD);
+        append_value(record, id);
+        append_value(record, static_cast<std::uint8_t>(site.level));
+        append_value(record, site.line);
+        append_text(record, site.file);
+        append_text(record, site.signature);
+        st.file.write(record.data(), static_cast<std::streamsize>(record.size()));
+    }
+
+    // Caller holds State::mutex
+    void write_chunk(State& st, const std::vector<char>& data)
+    {
+        if (st.file.is_open() && !data.empty())
+        {
+            st.file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        }
+    }
+
+    class Reader
+    {
+    public:
+        Reader(const char* data, std::size_t size) noexcept : m_data(data), m_size(size) {}
+
+        template<typename T>
+        bool read(T& value) noexcept
+        {
+            if (m_size - m_offset < sizeof(T)) return false;
+            std::memcpy(&value, m_data + m_offset, sizeof(T));
+            m_offset += sizeof(T);
+            return true;
+        }
+
+        bool read_text(std::string& text)
+        {
+            std::uint32_t length = 0;
+            if (!read(length) || m_size - m_offset < length) return false;
+            text.assign(m_data + m_offset, length);
+            m_offset += length;
+            return true;
+        }
+
+    private:
+        const char* m_data;
+        std::size_t m_size;
+        std::size_t m_offset    {0};
+    };
+
+    bool read_stream_text(std::istream& in, std::string& text)
+    {
+        std::uint32_t length = 0;
+        if (!in.read(reinterpret_cast<char*>(&length), sizeof(length))) return false;
+        text.resize(length);
+        return static_cast<bool>(in.read(text.data(), length));
+    }
+
+    // Renders the arguments exactly like ILogger::Format would have
+    bool decode_arguments(Reader& reader, const std::string& signature, std::string& message)
+    {
+        std::vector<std::string> values(signature.size());
+        for (std::size_t index = 0; index < signature.size(); ++index)
+        {
+            std::string& value = values[index];
+            switch (signature[index])
+            {
+                case 'b': { std::uint8_t v = 0; if (!reader.read(v)) return false; detail::append_value(value, v != 0); break; }
+                case 'c': { char v = 0; if (!reader.read(v)) return false; detail::append_value(value, v); break; }
+                case 'i': { std::int64_t v = 0; if (!reader.read(v)) return false; detail::append_value(value, v); break; }
+                case 'u': { std::uint64_t v = 0; if (!reader.read(v)) return false; detail::append_value(value, v); break; }
+                case 'd': { double v = 0; if (!reader.read(v)) return false; detail::append_value(value, v); break; }
+                case 'p':
+                {
+                    std::uint64_t v = 0;
+                    if (!reader.read(v)) return false;
+                    detail::append_value(value, reinterpret_cast<const void*>(static_cast<std::uintptr_t>(v)));
+                    break;
+                }
+                case 's': { if (!reader.read_text(value)) return false; break; }
+                default: return false;
+            }
+        }
+
+        std::vector<detail::FormatArg> args;
+        args.reserve(values.size());
+        for (const std::string& value : values) args.push_back(detail::make_format_arg(value));
+
+        // Only an original string argument can be a format string
+        if (!args.empty() && signature[0] != 's') args[0].is_text = false;
+
+        message.clear();
+        detail::format_into(message, args.data(), args.size());
+        return true;
+    }
+}
+
+namespace detail
+{
+    /**
+     * @brief Record buffer of one thread
+     *
+     * The owner appends under `mutex` (uncontended except during
+     * flush()); full chunks are swapped into `spare` and written
+     * without holding it.
+     */
+    struct BinaryLogBuffer
+    {
+        std::mutex mutex;
+        std::vector<char> data;
+        std::vector<char> spare;    ///< Owner only
+
+        BinaryLogBuffer()
+        {
+            data.reserve(CHUNK_SIZE + 256);
+
+            State& st = state();
+            std::lock_guard<std::mutex> lock(st.mutex);
+            st.buffers.push_back(this);
+        }
+
+        ~BinaryLogBuffer()
+        {
+            State& st = state();
+            std::lock_guard<std::mutex> lock(st.mutex);
+            std::erase(st.buffers, this);
+
+            std::lock_guard<std::mutex> own(mutex);
+            write_chunk(st, data);
+        }
+    };
+
+    namespace
+    {
+        BinaryLogBuffer& thread_buffer()
+        {
+            static thread_local BinaryLogBuffer buffer;
+            return buffer;
+        }
+    }
+
+    BinaryRecordWriter::BinaryRecordWriter(std::uint32_t site, LogLevel level)
+        : m_buffer(&thread_buffer()), m_level(level)
+    {
+        m_buffer->mutex.lock();
+        if (!state().active.load(std::memory_order_relaxed))
+        {
+            // Closed after the caller's is_active() check
+            m_buffer->mutex.unlock();
+            m_buffer = nullptr;
+            return;
+        }
+
+        std::vector<char>& data = m_buffer->data;
+        m_record_start = data.size();
+        data.push_back(MESSAGE_RECORD);
+        data.resize(data.size() + sizeof(std::uint32_t));   // Payload length, patched at the end
+
+        const std::int64_t time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            BinaryLog::Clock::now().time_since_epoch()).count();
+        append_raw(&site, sizeof(site));
+        append_raw(&time_ns, sizeof(time_ns));
+    }
+
+    BinaryRecordWriter::~BinaryRecordWriter()
+    {
+        if (!m_buffer) return;
+
+        std::vector<char>& data = m_buffer->data;
+        if (std::uncaught_exceptions() > m_exceptions)
+        {
+            data.resize(m_record_start);
+            m_buffer->mutex.unlock();
+            return;
+        }
+
+        const auto payload = static_cast<std::uint32_t>(data.size() - m_record_start - MESSAGE_HEADER_SIZE);
+        std::memcpy(data.data() + m_record_start + 1, &payload, sizeof(payload));
+
+        const bool full = data.size() >= CHUNK_SIZE;
+        if (full) data.swap(m_buffer->spare);
+        m_buffer->mutex.unlock();
+
+        if (full)
+        {
+            State& st = state();
+            {
+                std::lock_guard<std::mutex> lock(st.mutex);
+                write_chunk(st, m_buffer->spare);
+            }
+            m_buffer->spare.clear();
+        }
+
+        if (m_level == LogLevel::FATAL) BinaryLog::flush();
+    }
+
+    void BinaryRecordWriter::append_raw(const void* data, std::size_t size)
+    {
+        const auto* bytes = static_cast<const char*>(data);
+        m_buffer->data.insert(m_buffer->data.end(), bytes, bytes + size);
+    }
+
+    void BinaryRecordWriter::append_string(std::string_view text)
+    {
+        const auto length = static_cast<std::uint32_t>(text.size());
+        append_raw(&length, sizeof(length));
+        append_raw(text.data(), text.size());
+    }
+} // namespace detail
+
+void BinaryLog::open(const std::string& path)
+{
+    State& st = state();
+    std::lock_guard<std::mutex> lock(st.mutex);
+
+    if (st.file.is_open()) st.file.close();
+
+    st.file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!st.file.is_open())
+    {
+        throw std::runtime_error("Failed to open binary log file: " + path);
+    }
+
+    // Sites registered during an earlier capture are described up front
+    st.file.write(MAGIC, sizeof(MAGIC));
+    for (std::size_t id = 0; id < st.sites.size(); ++id)
+    {
+        write_site(st, static_cast<std::uint32_t>(id), st.sites[id]);
+    }
+    st.active.store(true);
+}
+
+void BinaryLog::close()
+{
+    State& st = state();
+    st.active.store(false);
+    flush();
+
+    std::lock_guard<std::mutex> lock(st.mutex);
+    if (st.file.is_open()) st.file.close();
+}
+
+void BinaryLog::flush()
+{
+    State& st = state();
+    std::lock_guard<std::mutex> lock(st.mutex);
+
+    for (detail::BinaryLogBuffer* buffer : st.buffers)
+    {
+        std::lock_guard<std::mutex> own(buffer->mutex);
+        write_chunk(st, buffer->data);
+        buffer->data.clear();
+    }
+    if (st.file.is_open()) st.file.flush();
+}
+
+bool BinaryLog::is_active() noexcept
+{
+    return state().active.load(std::memory_order_relaxed);
+}
+
+std::uint32_t BinaryLog::register_site(LogLevel level, const char* file, int line, std::string signature)
+{
+    State& st = state();
+    std::lock_guard<std::mutex> lock(st.mutex);
+
+    const auto id = static_cast<std::uint32_t>(st.sites.size());
+    st.sites.push_back(SiteInfo{ level, file, static_cast<std::int32_t>(line), std::move(signature) });
+
+    // Written before any record of the site can reach the file
+    if (st.file.is_open()) write_site(st, id, st.sites.back());
+    return id;
+}
+
+std::size_t BinaryLog::decode(std::istream& in, std::ostream& out)
+{
+    char magic[sizeof(MAGIC)] = {};
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        throw std::runtime_error("Not a RoboTact binary log");
+    }
+
+    struct Message
+    {
+        std::int64_t time_ns;
+        LogLevel level;
+        std::string text;
+    };
+
+    std::unordered_map<std::uint32_t, SiteInfo> sites;
+    std::vector<Message> messages;
+    std::vector<char> payload;
+
+    char kind = 0;
+    while (in.get(kind))
+    {
+        if (kind == SITE_RECORD)
+        {
+            std::uint32_t id = 0;
+            std::uint8_t level = 0;
+            SiteInfo site{};
+            if (!in.read(reinterpret_cast<char*>(&id), sizeof(id)) ||
+                !in.read(reinterpret_cast<char*>(&level), sizeof(level)) ||
+                !in.read(reinterpret_cast<char*>(&site.line), sizeof(site.line)) ||
+                !read_stream_text(in, site.file) || !read_stream_text(in, site.signature))
+            {
+                break;
+            }
+            site.level = static_cast<LogLevel>(level);
+            sites[id] = std::move(site);
+        }
+        else if (kind == MESSAGE_RECORD)
+        {
+            std::uint32_t length = 0;
+            if (!in.read(reinterpret_cast<char*>(&length), sizeof(length))) break;
+            payload.resize(length);
+            if (!in.read(payload.data(), length)) break;
+
+            Reader reader(payload.data(), payload.size());
+            std::uint32_t id = 0;
+            Message message{};
+            if (!reader.read(id) || !reader.read(message.time_ns)) continue;
+
+            const auto site = sites.find(id);
+            if (site == sites.end())
+            {
+                message.level = LogLevel::WARNING;
+                message.text = "<undescribed log site " + std::to_string(id) + ">";
+            }
+            else
+            {
+                message.level = site->second.level;
+                if (!decode_arguments(reader, site->second.signature, message.text))
+                {
+                    message.text = "<malformed record of " + site->second.file + ":" +
+                                   std::to_string(site->second.line) + ">";
+                }
+            }
+            messages.push_back(std::move(message));
+        }
+        else
+        {
+            throw std::runtime_error("Corrupt binary log: unknown record type");
+        }
+    }
+
+    // Thread buffers reach the file chunk by chunk, restore global order
+    std::stable_sort(messages.begin(), messages.end(),
+        [](const Message& a, const Message& b) { return a.time_ns < b.time_ns; });
+
+    for (const Message& message : messages)
+    {
+        const Clock::time_point time{ std::chrono::duration_cast<Clock::duration>(
+            std::chrono::nanoseconds(message.time_ns)) };
+        out << Logger::format_line(time, message.level, message.text) << '\n';
+    }
+    return messages.size();
+}
+
+} // namespace RoboTact::Core
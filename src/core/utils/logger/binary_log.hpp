@@ -0,0 +1,205 @@
+#ifndef BINARY_LOG_HPP
+#define BINARY_LOG_HPP
+
+/**
+ * @brief Binary capture mode for LOG_* calls with offline decoding
+ *
+ * While a binary log is open, LOG_* calls skip text formatting entirely:
+ * each call site registers a descriptor (level, file, line, argument
+ * types) once, and every call appends a compact record (site id,
+ * timestamp, raw argument bytes) to a per-thread buffer that is written
+ * to the file in large chunks. robotact-logdecode (tools/logdecode) turns
+ * the file back into the regular text format.
+ *
+ * Arguments are stored as:
+ * - bool and character types: 1 byte; integers and enums: 8 bytes;
+ *   floating point: 8 bytes
+ * - strings (std::string, string_view, C strings): u32 length + bytes
+ * - other pointers: 8-byte address
+ * - anything else: formatted with operator<< at the call site (slow path)
+ *
+ * The decoder applies the same formatting rules as ILogger::Format,
+ * including "{}" placeholders.
+ */
+
+#include "log_level.hpp"
+#include "log_format.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace RoboTact::Core
+{
+
+namespace detail
+{
+    /**
+     * @brief One-character type tag of a binary log argument
+     */
+    template<typename T>
+    constexpr char binary_log_tag() noexcept
+    {
+        using U = std::remove_cvref_t<T>;
+        if constexpr (std::is_same_v<U, bool>) return 'b';
+        else if constexpr (std::is_same_v<U, char> || std::is_same_v<U, signed char> ||
+                           std::is_same_v<U, unsigned char>) return 'c';
+        else if constexpr (std::is_enum_v<U>) return std::is_signed_v<std::underlying_type_t<U>> ? 'i' : 'u';
+        else if constexpr (std::is_integral_v<U>) return std::is_signed_v<U> ? 'i' : 'u';
+        else if constexpr (std::is_floating_point_v<U>) return 'd';
+        else if constexpr (std::is_convertible_v<const U&, std::string_view>) return 's';
+        else if constexpr (std::is_pointer_v<std::decay_t<U>>) return 'p';
+        else return 's';
+    }
+
+    struct BinaryLogBuffer;
+
+    /**
+     * @brief Appends one message record to the calling thread's buffer
+     *
+     * Discards the record if the log was closed meanwhile or an argument
+     * threw while being encoded.
+     */
+    class BinaryRecordWriter
+    {
+    public:
+        BinaryRecordWriter(std::uint32_t site, LogLevel level);
+        ~BinaryRecordWriter();
+
+        BinaryRecordWriter(const BinaryRecordWriter&) = delete;
+        BinaryRecordWriter& operator=(const BinaryRecordWriter&) = delete;
+
+        template<typename T>
+        void put(const T& arg)
+        {
+            if (!m_buffer) return;
+
+            using U = std::remove_cvref_t<T>;
+            constexpr char tag = binary_log_tag<T>();
+            if constexpr (tag == 'b' || tag == 'c')
+            {
+                append_raw(&arg, 1);
+            }
+            else if constexpr (std::is_enum_v<U>)
+            {
+                put(static_cast<std::underlying_type_t<U>>(arg));
+            }
+            else if constexpr (tag == 'i')
+            {
+                const auto value = static_cast<std::int64_t>(arg);
+                append_raw(&value, sizeof(value));
+            }
+            else if constexpr (tag == 'u')
+            {
+                const auto value = static_cast<std::uint64_t>(arg);
+                append_raw(&value, sizeof(value));
+            }
+            else if constexpr (tag == 'd')
+            {
+                const auto value = static_cast<double>(arg);
+                append_raw(&value, sizeof(value));
+            }
+            else if constexpr (tag == 'p')
+            {
+                const auto value = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(arg));
+                append_raw(&value, sizeof(value));
+            }
+            else if constexpr (std::is_convertible_v<const U&, std::string_view>)
+            {
+                if constexpr (std::is_pointer_v<U>)
+                {
+                    if (arg == nullptr)
+                    {
+                        append_string("(null)");
+                        return;
+                    }
+                }
+                append_string(std::string_view(arg));
+            }
+            else
+            {
+                std::string text;
+                append_value(text, arg);
+                append_string(text);
+            }
+        }
+
+    private:
+        void append_raw(const void* data, std::size_t size);
+        void append_string(std::string_view text);
+
+        BinaryLogBuffer* m_buffer;
+        LogLevel m_level;
+        std::size_t m_record_start      {0};
+        int m_exceptions                {std::uncaught_exceptions()};
+    };
+} // namespace detail
+
+/**
+ * @class BinaryLog
+ * @brief Process-wide binary log file (static, like ServiceLocator)
+ */
+class BinaryLog
+{
+public:
+    using Clock = std::chrono::system_clock;
+
+    BinaryLog() = delete;
+
+    /**
+     * @brief Starts capturing LOG_* calls into `path` (truncated)
+     * @throws std::runtime_error If the file cannot be opened
+     */
+    static void open(const std::string& path);
+
+    /**
+     * @brief Writes out all thread buffers and stops capturing
+     */
+    static void close();
+
+    /**
+     * @brief Writes out all thread buffers (also done on every FATAL record)
+     */
+    static void flush();
+
+    [[nodiscard]] static bool is_active() noexcept;
+
+    /**
+     * @brief Assigns the descriptor id of a call site (once per site)
+     */
+    static std::uint32_t register_site(LogLevel level, const char* file, int line, std::string signature);
+
+    /**
+     * @brief Appends one record; `Site` is a per-call-site tag type
+     *
+     * LOG_IMPL passes a fresh lambda, so the static id below is
+     * registered exactly once per call site.
+     */
+    template<typename Site, typename... Args>
+    static void write(Site, LogLevel level, const char* file, int line, const Args&... args)
+    {
+        static const std::uint32_t site = register_site(level, file, line,
+                                                        std::string{ detail::binary_log_tag<Args>()... });
+
+        detail::BinaryRecordWriter record(site, level);
+        (record.put(args), ...);
+    }
+
+    /**
+     * @brief Converts a binary log to text lines, ordered by timestamp
+     * @return Number of decoded messages
+     * @throws std::runtime_error If the stream is not a binary log
+     *
+     * A truncated final record (e.g. after a crash) is ignored.
+     */
+    static std::size_t decode(std::istream& in, std::ostream& out);
+};
+
+} // namespace RoboTact::Core
+
+#endif // BINARY_LOG_HPP
@@ -0,0 +1,123 @@
+#include "log_format.hpp"
+
+#include <sstream>
+
+namespace RoboTact::Core::detail
+{
+
+namespace
+{
+    /**
+     * @brief Marks a per-thread buffer busy; a nested use (an operator<<
+     * that logs) falls back to a local one
+     */
+    class ReuseGuard
+    {
+    public:
+        explicit ReuseGuard(bool& in_use) noexcept : m_in_use(in_use), m_acquired(!in_use) { m_in_use = true; }
+        ~ReuseGuard() { if (m_acquired) m_in_use = false; }
+
+        ReuseGuard(const ReuseGuard&) = delete;
+        ReuseGuard& operator=(const ReuseGuard&) = delete;
+
+        [[nodiscard]] bool acquired() const noexcept { return m_acquired; }
+
+    private:
+        bool& m_in_use;
+        const bool m_acquired;
+    };
+}
+
+void append_stream_value(std::string& out, void (*write)(std::ostream&, const void*), const void* value)
+{
+    thread_local std::ostringstream t_stream;
+    thread_local bool t_in_use = false;
+
+    ReuseGuard guard(t_in_use);
+    if (!guard.acquired())
+    {
+        std::ostringstream local;
+        write(local, value);
+        out += local.view();
+        return;
+    }
+
+    t_stream.str(std::string());
+    t_stream.clear();
+    write(t_stream, value);
+    out += t_stream.view();
+}
+
+void format_into(std::string& out, const FormatArg* args, std::size_t count)
+{
+    std::size_t next = 0;
+
+    if (count >= 2 && args[0].is_text && args[0].text.find("{}") != std::string_view::npos)
+    {
+        const std::string_view format = args[0].text;
+        next = 1;
+
+        for (std::size_t i = 0; i < format.size(); ++i)
+        {
+            const char c = format[i];
+            const char following = i + 1 < format.size() ? format[i + 1] : '\0';
+
+            if (c == '{' && following == '}')
+            {
+                if (next < count)
+                {
+                    args[next].append(out, args[next].value);
+                    ++next;
+                }
+                else
+                {
+                    out += "{}";
+                }
+                ++i;
+            }
+            else if ((c == '{' && following == '{') || (c == '}' && following == '}'))
+            {
+                out += c;
+                ++i;
+            }
+            else
+            {
+                out += c;
+            }
+        }
+
+        // Arguments without a placeholder are kept, space-separated
+        for (; next < count; ++next)
+        {
+            out += ' ';
+            args[next].append(out, args[next].value);
+        }
+        return;
+    }
+
+    for (; next < count; ++next)
+    {
+        if (next > 0) out += ' ';
+        args[next].append(out, args[next].value);
+    }
+}
+
+std::string format_message(const FormatArg* args, std::size_t count)
+{
+    thread_local std::string t_buffer;
+    thread_local bool t_in_use = false;
+
+    ReuseGuard guard(t_in_use);
+    if (!guard.acquired())
+    {
+        std::string local;
+        format_into(local, args, count);
+        return local;
+    }
+
+    t_buffer.clear();
+    format_into(t_buffer, args, count);
+    return t_buffer;
+}
+
+} // namespace RoboTact::Core::detail
@@ -0,0 +1,142 @@
+#ifndef LOG_FORMAT_HPP
+#define LOG_FORMAT_HPP
+
+/**
+ * @brief Single-pass message formatting for the logger
+ *
+ * Two call styles are supported:
+ * - space-separated: LOG_INFO("Loaded", count, "meshes") -> "Loaded 12 meshes"
+ * - placeholders: LOG_INFO("Loaded {} meshes", count) -> "Loaded 12 meshes"
+ *
+ * Placeholder style is used when the first argument is a string
+ * containing "{}" and more arguments follow; "{{" and "}}" then produce
+ * literal braces, and arguments left over are appended space-separated.
+ *
+ * Values are written straight into one string: numbers through
+ * std::to_chars (same output as the default ostream formatting), other
+ * types through their operator<< using a reused per-thread stream.
+ * As with ostream, char, signed char and unsigned char (hence also
+ * std::int8_t/std::uint8_t) print as characters; cast to int for a number.
+ */
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace RoboTact::Core::detail
+{
+    void append_stream_value(std::string& out, void (*write)(std::ostream&, const void*), const void* value);
+
+    template<typename T>
+    concept LogStreamable = requires(std::ostream& os, const T& value) { os << value; };
+
+    /**
+     * @brief Appends the text form of `value`, as operator<< would print it
+     */
+    template<typename T>
+    void append_value(std::string& out, const T& value)
+    {
+        using U = std::remove_cvref_t<T>;
+        if constexpr (std::is_convertible_v<const U&, std::string_view>)
+        {
+            if constexpr (std::is_pointer_v<U>)
+            {
+                if (value == nullptr)
+                {
+                    out += "(null)";
+                    return;
+                }
+            }
+            out += std::string_view(value);
+        }
+        else if constexpr (std::is_same_v<U, char> || std::is_same_v<U, signed char> ||
+                           std::is_same_v<U, unsigned char>)
+        {
+            // Characters, like operator<<; this includes std::int8_t/std::uint8_t
+            out += static_cast<char>(value);
+        }
+        else if constexpr (std::is_same_v<U, bool>)
+        {
+            out += value ? '1' : '0';
+        }
+        else if constexpr (std::is_integral_v<U> || std::is_floating_point_v<U>)
+        {
+            char digits[32];
+            std::to_chars_result result;
+            if constexpr (std::is_floating_point_v<U>)
+            {
+                // %g with the default stream precision
+                result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::general, 6);
+            }
+            else
+            {
+                result = std::to_chars(digits, digits + sizeof(digits), value);
+            }
+            out.append(digits, result.ptr);
+        }
+        else if constexpr (LogStreamable<U>)
+        {
+            append_stream_value(out, [](std::ostream& os, const void* p) { os << *static_cast<const U*>(p); },
+                                &value);
+        }
+        else if constexpr (std::is_enum_v<U>)
+        {
+            // Promoted, so enums over std::uint8_t still print as numbers
+            append_value(out, +static_cast<std::underlying_type_t<U>>(value));
+        }
+        else
+        {
+            static_assert(LogStreamable<U>, "Log arguments need an operator<<");
+        }
+    }
+
+    /**
+     * @brief Type-erased reference to one argument of a log call
+     */
+    struct FormatArg
+    {
+        const void* value;
+        void (*append)(std::string&, const void*);
+        std::string_view text;  ///< Set for string arguments (candidate format strings)
+        bool is_text;
+    };
+
+    template<typename T>
+    FormatArg make_format_arg(const T& value) noexcept
+    {
+        FormatArg arg{ &value, [](std::string& out, const void* p) { append_value(out, *static_cast<const T*>(p)); },
+                       {}, false };
+
+        using U = std::remove_cvref_t<T>;
+        if constexpr (std::is_convertible_v<const U&, std::string_view>)
+        {
+            if constexpr (std::is_pointer_v<U>)
+            {
+                if (value == nullptr) return arg;
+            }
+            arg.text = std::string_view(value);
+            arg.is_text = true;
+        }
+        return arg;
+    }
+
+    /**
+     * @brief Appends all arguments to `out` in one pass (see file comment)
+     */
+    void format_into(std::string& out, const FormatArg* args, std::size_t count);
+
+    /**
+     * @brief Formats into a reused per-thread buffer and returns a copy
+     *
+     * The copy is the only allocation of a typical log call.
+     */
+    std::string format_message(const FormatArg* args, std::size_t count);
+
+} // namespace RoboTact::Core::detail
+
+#endif // LOG_FORMAT_HPP
@@ -0,0 +1,25 @@
+#ifndef LOG_LEVEL_HPP
+#define LOG_LEVEL_HPP
+
+namespace RoboTact::Core
+{
+
+/**
+ * @enum LogLevel
+ * @brief Severity levels for log messages
+ * 
+ * Messages with lower severity than the current threshold will be filtered out.
+ */
+enum class LogLevel
+{
+    TRACE,   
+    DEBUG,   
+    INFO,    
+    WARNING, 
+    ERROR,   
+    FATAL    
+};
+
+} // namespace RoboTact::Core
+
+#endif // LOG_LEVEL_HPP
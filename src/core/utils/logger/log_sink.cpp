@@ -0,0 +1,98 @@
+#include "log_sink.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace RoboTact::Core
+{
+
+namespace
+{
+    std::string_view log_level_to_color(LogLevel level) noexcept
+    {
+        switch (level) 
+        {
+            case LogLevel::TRACE:   return "\033[37m";       // White
+            case LogLevel::DEBUG:   return "\033[36m";       // Cyan
+            case LogLevel::INFO:    return "\033[32m";       // Green
+            case LogLevel::WARNING: return "\033[33m";       // Yellow
+            case LogLevel::ERROR:   return "\033[31m";       // Red
+            case LogLevel::FATAL:   return "\033[41m\033[97m"; // Red bg, White text
+            default:                return "\033[0m";        // Reset
+        }
+    }
+}
+
+void ConsoleSink::write(LogLevel level, std::string_view line)
+{
+    if (m_use_color)
+    {
+        // Set back console color to default afterwards
+        std::cout << log_level_to_color(level) << line << "\033[0m\n";
+    }
+    else
+    {
+        std::cout << line << '\n';
+    }
+}
+
+void ConsoleSink::flush()
+{
+    std::cout.flush();
+}
+
+FileSink::FileSink(const std::string& file_name, LogSinkConfig config)
+    : ILogSink(config)
+{
+    m_file.open(file_name, std::ios::out | std::ios::app);
+    if (!m_file.is_open())
+    {
+        throw std::runtime_error("Failed to open log file: " + file_name);
+    }
+}
+
+void FileSink::write(LogLevel, std::string_view line)
+{
+    m_file << line << '\n';
+}
+
+void FileSink::flush()
+{
+    m_file.flush();
+}
+
+RingBufferSink::RingBufferSink(std::size_t capacity, LogSinkConfig config)
+    : ILogSink(config), m_slots(std::max<std::size_t>(capacity, 1))
+{
+}
+
+void RingBufferSink::write(LogLevel level, std::string_view line)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // assign() reuses the slot's capacity once the ring has wrapped
+    Slot& slot = m_slots[m_next];
+    slot.level = level;
+    slot.text.assign(line);
+
+    m_next = (m_next + 1) % m_slots.size();
+    m_size = std::min(m_size + 1, m_slots.size());
+    m_sequence.fetch_add(1, std::memory_order_release);
+}
+
+void RingBufferSink::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_next = 0;
+    m_size = 0;
+    m_sequence.fetch_add(1, std::memory_order_release);
+}
+
+std::size_t RingBufferSink::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_size;
+}
+
+} // namespace RoboTact::Core
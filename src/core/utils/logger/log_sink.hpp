@@ -0,0 +1,197 @@
+#ifndef LOG_SINK_HPP
+#define LOG_SINK_HPP
+
+/**
+ * @brief Output destinations of the logger
+ *
+ * Every record is formatted once and handed to each registered sink whose
+ * level accepts it. Sinks write without flushing; the logger flushes
+ * each sink according to its LogFlushPolicy, so console and file output
+ * cost one flush per batch (or per severe message) instead of per line.
+ *
+ * Provided sinks:
+ * - ConsoleSink: colored std::cout output
+ * - FileSink: appends to a text file
+ * - SegmentedFileSink: rotating memory-mapped segments (segmented_file_sink.hpp)
+ * - RingBufferSink: last N lines in memory, for an in-app log console
+ */
+
+#include "log_level.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace RoboTact::Core
+{
+
+/**
+ * @enum LogFlushPolicy
+ * @brief When the logger flushes a sink
+ */
+enum class LogFlushPolicy
+{
+    EVERY_LINE,     ///< After each line (slowest, nothing is ever buffered)
+    EVERY_BATCH,    ///< After each batch: one line when synchronous, one writer drain when async
+    ON_SEVERITY     ///< Only once a batch contains a line at or above `flush_level`
+};
+
+/**
+ * @struct LogSinkConfig
+ * @brief Filtering and flushing parameters of a sink
+ */
+struct LogSinkConfig
+{
+    LogLevel level                  {LogLevel::TRACE};      ///< Lines below are not written to this sink
+    LogFlushPolicy flush_policy     {LogFlushPolicy::EVERY_BATCH};
+    LogLevel flush_level            {LogLevel::ERROR};      ///< Threshold of ON_SEVERITY
+};
+
+/**
+ * @class ILogSink
+ * @brief Destination of formatted log lines
+ *
+ * write() and flush() are only called by the logger, serialized by its
+ * lock, so implementations need no locking of their own unless they
+ * are read from elsewhere.
+ */
+class ILogSink
+{
+public:
+    explicit ILogSink(LogSinkConfig config = {}) noexcept
+        : m_level(config.level), m_flush_policy(config.flush_policy), m_flush_level(config.flush_level) {}
+
+    virtual ~ILogSink() = default;
+
+    ILogSink(const ILogSink&) = delete;
+    ILogSink& operator=(const ILogSink&) = delete;
+
+    /**
+     * @brief Writes one line (without trailing newline)
+     * @param level Severity of the line
+     * @param line Timestamp, level tag and message
+     */
+    virtual void write(LogLevel level, std::string_view line) = 0;
+
+    /**
+     * @brief Pushes buffered output to its destination
+     */
+    virtual void flush() = 0;
+
+    void set_level(LogLevel level) noexcept { m_level.store(level, std::memory_order_relaxed); }
+    [[nodiscard]] LogLevel get_level() const noexcept { return m_level.load(std::memory_order_relaxed); }
+    [[nodiscard]] bool accepts(LogLevel level) const noexcept { return level >= get_level(); }
+
+    [[nodiscard]] LogFlushPolicy get_flush_policy() const noexcept { return m_flush_policy; }
+    [[nodiscard]] LogLevel get_flush_level() const noexcept { return m_flush_level; }
+
+private:
+    std::atomic<LogLevel> m_level;
+    const LogFlushPolicy m_flush_policy;
+    const LogLevel m_flush_level;
+};
+
+/**
+ * @class ConsoleSink
+ * @brief Writes color-coded lines to std::cout
+ */
+class ConsoleSink final : public ILogSink
+{
+public:
+    explicit ConsoleSink(LogSinkConfig config = {}, bool use_color = true) noexcept
+        : ILogSink(config), m_use_color(use_color) {}
+
+    void write(LogLevel level, std::string_view line) override;
+    void flush() override;
+
+private:
+    const bool m_use_color;
+};
+
+/**
+ * @class FileSink
+ * @brief Appends lines to a text file
+ */
+class FileSink final : public ILogSink
+{
+public:
+    /**
+     * @throws std::runtime_error If the file cannot be opened
+     */
+    explicit FileSink(const std::string& file_name, LogSinkConfig config = {});
+
+    void write(LogLevel level, std::string_view line) override;
+    void flush() override;
+
+private:
+    std::ofstream m_file;
+};
+
+/**
+ * @class RingBufferSink
+ * @brief Keeps the most recent lines in a fixed set of reused slots
+ *
+ * Meant for an on-screen log console: visit() hands out views of the
+ * stored lines, so the UI renders them without copying. Slots keep
+ * their string capacity, so steady-state writes do not allocate.
+ */
+class RingBufferSink final : public ILogSink
+{
+public:
+    explicit RingBufferSink(std::size_t capacity = 1024, LogSinkConfig config = {});
+
+    void write(LogLevel level, std::string_view line) override;
+    void flush() override {}
+
+    /**
+     * @brief Calls `visitor(LogLevel, std::string_view)` for each stored
+     *        line, oldest first
+     *
+     * Holds the sink's lock meanwhile: the views are only valid inside
+     * the call, and logging waits for the visit to finish.
+     */
+    template<typename Visitor>
+    void visit(Visitor&& visitor) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const std::size_t first = (m_next + m_slots.size() - m_size) % m_slots.size();
+        for (std::size_t i = 0; i < m_size; ++i)
+        {
+            const Slot& slot = m_slots[(first + i) % m_slots.size()];
+            visitor(slot.level, std::string_view(slot.text));
+        }
+    }
+
+    void clear();
+
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_slots.size(); }
+
+    /**
+     * @brief Total lines written so far; changes whenever content changes
+     *        (e.g. to auto-scroll a console)
+     */
+    [[nodiscard]] std::uint64_t sequence() const noexcept { return m_sequence.load(std::memory_order_acquire); }
+
+private:
+    struct Slot
+    {
+        LogLevel level      {LogLevel::TRACE};
+        std::string text;
+    };
+
+    mutable std::mutex m_mutex;
+    std::vector<Slot> m_slots;
+    std::size_t m_next                      {0};
+    std::size_t m_size                      {0};
+    std::atomic<std::uint64_t> m_sequence   {0};
+};
+
+} // namespace RoboTact::Core
+
+#endif // LOG_SINK_HPP
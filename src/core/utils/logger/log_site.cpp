@@ -0,0 +1,109 @@
+#include "log_site.hpp"
+#include "logger.hpp"
+
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace RoboTact::Core
+{
+
+namespace
+{
+    /**
+     * @brief Sites that have collapsed a message at least once
+     *
+     * Sites are function-local statics, so the pointers stay valid for
+     * the life of the process.
+     */
+    struct RepeatRegistry
+    {
+        std::mutex mutex;
+        std::vector<detail::LogSite*> sites;
+    };
+
+    RepeatRegistry& repeat_registry()
+    {
+        static RepeatRegistry registry;
+        return registry;
+    }
+
+    void register_site(detail::LogSite& site)
+    {
+        if (site.registered.exchange(true, std::memory_order_relaxed)) return;
+
+        auto& registry = repeat_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.sites.push_back(&site);
+    }
+
+    void log_repeats(ILogger& logger, const detail::LogSite& site, std::uint64_t repeats)
+    {
+        std::string_view file(site.file);
+        if (const auto slash = file.find_last_of("/\\"); slash != std::string_view::npos)
+        {
+            file.remove_prefix(slash + 1);
+        }
+        logger.log(site.level, ILogger::Format("Last message repeated {} times ({}:{})", repeats, file, site.line));
+    }
+}
+
+void flush_log_repeats(ILogger& logger)
+{
+    auto& registry = repeat_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (detail::LogSite* site : registry.sites)
+    {
+        if (const auto repeats = site->repeats.exchange(0, std::memory_order_relaxed))
+        {
+            log_repeats(logger, *site, repeats);
+        }
+        // The next message from the site starts a fresh window
+        site->last_hash.store(0, std::memory_order_relaxed);
+    }
+}
+
+namespace detail
+{
+    void log_from_site(ILogger& logger, LogSite& site, std::string message)
+    {
+        if (site.collapse && site.level != LogLevel::FATAL)
+        {
+            const std::int64_t now = log_site_now_ns();
+
+            // Low bit set so a real hash never equals the "none" value
+            const std::uint64_t hash = std::hash<std::string_view>{}(message) | 1;
+            const std::uint64_t previous = site.last_hash.exchange(hash, std::memory_order_relaxed);
+            const auto window = std::chrono::duration_cast<std::chrono::nanoseconds>(LOG_REPEAT_WINDOW).count();
+            if (previous == hash && now - site.last_logged.load(std::memory_order_relaxed) < window)
+            {
+                if (site.repeats.fetch_add(1, std::memory_order_relaxed) == 0)
+                {
+                    register_site(site);
+                }
+                return;
+            }
+
+            site.last_logged.store(now, std::memory_order_relaxed);
+            if (const auto repeats = site.repeats.exchange(0, std::memory_order_relaxed))
+            {
+                log_repeats(logger, site, repeats);
+            }
+        }
+
+        // Only EVERY_MS sites skip calls; the load keeps the others read-only
+        if (site.skipped.load(std::memory_order_relaxed) != 0)
+        {
+            if (const auto skipped = site.skipped.exchange(0, std::memory_order_relaxed))
+            {
+                message += " [";
+                append_value(message, skipped);
+                message += " similar skipped]";
+            }
+        }
+        logger.log(site.level, message);
+    }
+}
+
+} // namespace RoboTact::Core
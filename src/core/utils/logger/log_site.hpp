@@ -0,0 +1,120 @@
+#ifndef LOG_SITE_HPP
+#define LOG_SITE_HPP
+
+/**
+ * @brief Per-call-site state of LOG_* macros: rate limiting and repeat
+ *        collapsing
+ *
+ * Every LOG_* expansion owns one static LogSite (constant-initialized,
+ * so it costs no guard or allocation). It is used for:
+ * - rate limiting: LOG_*_EVERY_N logs the 1st, (N+1)th, ... call;
+ *   LOG_*_EVERY_MS logs at most once per interval and reports how many
+ *   calls were skipped on the next line it lets through
+ * - repeat collapsing (LOG_*_COLLAPSED only): a message identical to the
+ *   previous one from the same site within LOG_REPEAT_WINDOW is only
+ *   counted. The count is logged as "Last message repeated N times" with
+ *   the next line the site lets through (a different message, or the
+ *   same one after the window) or by flush_log_repeats(); a site that
+ *   goes quiet keeps its count until then, nothing is logged on expiry.
+ *
+ * Collapsing hashes every message, so it is opt-in for sites that may
+ * spam; other sites pay nothing for it. FATAL messages are never
+ * collapsed. Messages captured by the binary log bypass collapsing (they
+ * are not formatted at the call site).
+ */
+
+#include "log_level.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace RoboTact::Core
+{
+
+class ILogger;
+
+/**
+ * @brief Identical messages from one site are collapsed within this window
+ */
+inline constexpr std::chrono::seconds LOG_REPEAT_WINDOW{10};
+
+/**
+ * @brief Logs the pending "Last message repeated N times" line of every
+ *        site (call before shutting the logger down)
+ */
+void flush_log_repeats(ILogger& logger);
+
+namespace detail
+{
+    inline std::int64_t log_site_now_ns() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * @brief Static state of one LOG_* call site
+     *
+     * Updated with relaxed atomics only; concurrent callers may skew a
+     * count by a few, never lose a message that should be logged.
+     */
+    struct LogSite
+    {
+        const char* file;
+        int line;
+        LogLevel level;
+        bool collapse;                                  ///< Repeat collapsing enabled (LOG_*_COLLAPSED)
+
+        std::atomic<std::uint64_t> calls        {0};    ///< EVERY_N counter
+        std::atomic<std::int64_t> next_allowed  {0};    ///< EVERY_MS deadline (steady ns)
+        std::atomic<std::uint64_t> skipped      {0};    ///< EVERY_MS calls not logged since the last line
+        std::atomic<std::uint64_t> last_hash    {0};    ///< Hash of the last message (0 = none)
+        std::atomic<std::int64_t> last_logged   {0};    ///< When that message was last written (steady ns)
+        std::atomic<std::uint64_t> repeats      {0};    ///< Identical messages collapsed since then
+        std::atomic<bool> registered            {false};
+
+        constexpr LogSite(const char* site_file, int site_line, LogLevel site_level,
+                          bool site_collapse = false) noexcept
+            : file(site_file), line(site_line), level(site_level), collapse(site_collapse) {}
+
+        LogSite(const LogSite&) = delete;
+        LogSite& operator=(const LogSite&) = delete;
+
+        /**
+         * @brief True for the 1st, (n+1)th, (2n+1)th, ... call
+         */
+        bool every_n(std::uint64_t n) noexcept
+        {
+            return n <= 1 || calls.fetch_add(1, std::memory_order_relaxed) % n == 0;
+        }
+
+        /**
+         * @brief True at most once per `interval_ms`
+         */
+        bool every_ms(std::int64_t interval_ms) noexcept
+        {
+            const std::int64_t now = log_site_now_ns();
+            std::int64_t next = next_allowed.load(std::memory_order_relaxed);
+            if (now >= next &&
+                next_allowed.compare_exchange_strong(next, now + interval_ms * 1'000'000,
+                                                     std::memory_order_relaxed))
+            {
+                return true;
+            }
+            skipped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    };
+
+    /**
+     * @brief Logs `message` from `site`, collapsing repeats (see file comment)
+     */
+    void log_from_site(ILogger& logger, LogSite& site, std::string message);
+
+} // namespace detail
+
+} // namespace RoboTact::Core
+
+#endif // LOG_SITE_HPP
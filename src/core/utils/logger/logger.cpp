@@ -1,40 +1,127 @@
 #include "logger.hpp"
+#include "spsc_ring_buffer.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <ctime>
+#include <limits>
+#include <utility>
 
 namespace RoboTact::Core
 {
 
-Logger::~Logger()
+namespace
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    if (m_log_file.is_open())
+    // Logger whose writer thread the calling thread is
+    thread_local const Logger* t_writer_of = nullptr;
+
+    // Logger whose sinks the calling thread is inside of (m_mutex held)
+    thread_local const Logger* t_in_sinks_of = nullptr;
+
+    /**
+     * @brief Marks the calling thread as inside a Logger's sinks
+     */
+    class SinkCallScope
     {
-        m_log_file.close();
-    }
+    public:
+        explicit SinkCallScope(const Logger* logger) noexcept
+            : m_previous(std::exchange(t_in_sinks_of, logger)) {}
+
+        ~SinkCallScope() { t_in_sinks_of = m_previous; }
+
+        SinkCallScope(const SinkCallScope&) = delete;
+        SinkCallScope& operator=(const SinkCallScope&) = delete;
+
+    private:
+        const Logger* m_previous;
+    };
 }
 
-void Logger::init(const std::string& file_name, LogLevel level)
+/**
+ * @brief Records queued by one thread, drained only by the writer
+ */
+struct Logger::ProducerRing
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    explicit ProducerRing(std::size_t capacity) : queue(capacity) {}
+
+    SpscRingBuffer<Record> queue;
+    std::atomic<bool> publishing            {false};    ///< Producer is between its mode check and push
+    std::atomic<bool> retired               {false};    ///< Owning thread has exited
+    std::atomic<std::uint64_t> dropped      {0};        ///< Written by the producer only
+    std::uint64_t dropped_reported          {0};        ///< Writer's view of `dropped`
+};
 
-    // Close the existing log file if open
-    if (m_log_file.is_open())
+/**
+ * @brief Rings of the calling thread, one per Logger it has used
+ */
+struct Logger::ThreadRings
+{
+    std::vector<std::pair<std::uint64_t, std::shared_ptr<ProducerRing>>> rings;
+
+    ~ThreadRings()
     {
-        m_log_file.close();
+        // Lets the writer forget the rings once they are drained
+        for (auto& entry : rings) entry.second->retired.store(true, std::memory_order_release);
     }
+};
+
+std::uint64_t Logger::next_id() noexcept
+{
+    static std::atomic<std::uint64_t> counter {0};
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
 
-    // Open new log file if specified filename
+Logger::~Logger()
+{
+    stop_async();
+    flush_sinks();
+}
+
+void Logger::init(const std::string& file_name, LogLevel level)
+{
+    // Open the new log file first, a failure leaves the logger unchanged
+    std::shared_ptr<ILogSink> file_sink;
     if (!file_name.empty())
     {
-        m_log_file.open(file_name, std::ios::out | std::ios::app);
-        if (!m_log_file.is_open())
+        file_sink = std::make_shared<FileSink>(file_name);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
         {
-            throw std::runtime_error("Failed to open log file: " + file_name);
+            SinkCallScope scope(this);
+            for (const auto& sink : m_sinks) sink->flush();
         }
+
+        m_sinks.clear();
+        m_sinks.push_back(std::make_shared<ConsoleSink>());
+        if (file_sink) m_sinks.push_back(std::move(file_sink));
     }
 
     m_log_level.store(level);
 }
 
+void Logger::add_sink(std::shared_ptr<ILogSink> sink)
+{
+    if (!sink) return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sinks.push_back(std::move(sink));
+}
+
+void Logger::remove_sink(const std::shared_ptr<ILogSink>& sink)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = std::find(m_sinks.begin(), m_sinks.end(), sink);
+    if (it == m_sinks.end()) return;
+
+    {
+        SinkCallScope scope(this);
+        (*it)->flush();
+    }
+    m_sinks.erase(it);
+}
+
 void Logger::set_log_level(LogLevel level)
 {
     m_log_level.store(level);
@@ -45,41 +132,371 @@ void Logger::log(LogLevel level, const std::string& message)
     // Early exit if message level is below threshold
     if (level < m_log_level.load()) { return; }
 
-    // Format the log message
-    std::ostringstream oss;
-    oss << get_time_stamp() 
-        << " [" << log_level_to_string(level) << "] " 
-        << message;
+    Record record{ {}, level, message };
+    if (m_timestamp_mode.load(std::memory_order_relaxed) == LogTimestampMode::MONOTONIC_NS)
+    {
+        record.monotonic_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    else
+    {
+        record.time = Clock::now();
+    }
 
+    // A FATAL message must be on disk before the process goes down, after
+    // everything logged ahead of it
+    if (level == LogLevel::FATAL)
+    {
+        flush();
+        write_sync(std::move(record));
+        return;
+    }
 
-    // Thread-safe output operations
+    // Not from the writer thread (a sink logging): BLOCK would spin on a
+    // ring that only this thread drains
+    if (t_writer_of != this && m_async.load() && try_enqueue(record)) { return; }
+
+    write_sync(std::move(record));
+}
+
+void Logger::write_sync(Record&& record)
+{
+    // Logged by a sink: m_mutex is already held by this thread, so the
+    // record is written right after the current batch instead
+    if (t_in_sinks_of == this)
+    {
+        m_deferred.push_back(std::move(record));
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    write_locked(&record, 1);
+}
+
+void Logger::write_locked(const Record* records, std::size_t count)
+{
+    SinkCallScope scope(this);
+    write_batch(records, count);
+
+    // What the sinks log while these are written waits for the next write,
+    // so a sink that logs on every line cannot keep us here
+    if (!m_deferred.empty())
+    {
+        std::vector<Record> deferred;
+        deferred.swap(m_deferred);
+        write_batch(deferred.data(), deferred.size());
+    }
+}
+
+void Logger::write_batch(const Record* records, std::size_t count)
+{
+    LogLevel highest = LogLevel::TRACE;
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        const Record& record = records[index];
+        highest = std::max(highest, record.level);
+
+        // Formatted once, whatever the number of sinks
+        const std::string line = format_line(record);
+        for (const auto& sink : m_sinks)
+        {
+            if (!sink->accepts(record.level)) continue;
+
+            sink->write(record.level, line);
+            if (sink->get_flush_policy() == LogFlushPolicy::EVERY_LINE) sink->flush();
+        }
+    }
+
+    for (const auto& sink : m_sinks)
+    {
+        const LogFlushPolicy policy = sink->get_flush_policy();
+        if (policy == LogFlushPolicy::EVERY_BATCH ||
+            (policy == LogFlushPolicy::ON_SEVERITY && highest >= sink->get_flush_level()))
+        {
+            sink->flush();
+        }
+    }
+}
+
+void Logger::flush_sinks()
+{
     std::lock_guard<std::mutex> lock(m_mutex);
-    
-    const std::string log_message = oss.str();
-    
-    // Colorized console output
-    std::cout << log_level_to_color(level) 
-              << log_message 
-              << "\033[0m" << std::endl; // Set back console color to default
+    SinkCallScope scope(this);
+    for (const auto& sink : m_sinks) sink->flush();
+}
+
+void Logger::flush()
+{
+    // From a sink or the writer thread: the flush would wait on this thread
+    if (t_in_sinks_of == this || t_writer_of == this) return;
+
+    if (!m_async.load())
+    {
+        flush_sinks();
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_writer_mutex);
+    const std::uint64_t target = ++m_flush_requested;
+    m_writer_cv.notify_one();
+    m_flush_cv.wait(lock, [this, target]() { return m_flush_completed >= target || m_writer_stop; });
+}
+
+void Logger::start_async(AsyncLogConfig config)
+{
+    std::lock_guard<std::mutex> control(m_control_mutex);
+    if (m_async.load()) return;
+
+    m_async_config = config;
+    {
+        std::lock_guard<std::mutex> lock(m_writer_mutex);
+        m_writer_stop = false;
+    }
+    m_writer = std::thread(&Logger::writer_loop, this);
+    m_async.store(true);
+}
+
+void Logger::stop_async()
+{
+    std::lock_guard<std::mutex> control(m_control_mutex);
+    if (!m_async.exchange(false)) return;
+
+    // Producers that still saw the async mode finish their push first;
+    // later ones write synchronously
+    std::vector<std::shared_ptr<ProducerRing>> rings;
+    {
+        std::lock_guard<std::mutex> lock(m_rings_mutex);
+        rings = m_rings;
+    }
+    for (const auto& ring : rings)
+    {
+        // seq_cst like the m_async exchange above and the producer's
+        // publishing store: otherwise both sides may miss each other
+        while (ring->publishing.load()) std::this_thread::yield();
+    }
 
-    // File output (if enabled)
-    if (m_log_file.is_open()) 
     {
-        m_log_file << log_message << std::endl;
+        std::lock_guard<std::mutex> lock(m_writer_mutex);
+        m_writer_stop = true;
     }
+    m_writer_cv.notify_all();
+    m_writer.join();
+}
+
+std::uint64_t Logger::dropped_count() const noexcept
+{
+    return m_dropped_total.load(std::memory_order_relaxed);
 }
 
-std::string Logger::get_time_stamp() 
+Logger::ProducerRing& Logger::thread_ring()
+{
+    static thread_local ThreadRings t_rings;
+
+    for (auto& entry : t_rings.rings)
+    {
+        if (entry.first == m_id) return *entry.second;
+    }
+
+    auto ring = std::make_shared<ProducerRing>(m_async_config.queue_capacity);
+    {
+        std::lock_guard<std::mutex> lock(m_rings_mutex);
+        m_rings.push_back(ring);
+    }
+    t_rings.rings.emplace_back(m_id, ring);
+    return *ring;
+}
+
+bool Logger::try_enqueue(Record& record)
+{
+    ProducerRing& ring = thread_ring();
+
+    // Pairs with stop_async(): either it waits for this push, or we see
+    // the mode switched off and write synchronously
+    ring.publishing.store(true);
+    if (!m_async.load())
+    {
+        ring.publishing.store(false, std::memory_order_release);
+        return false;
+    }
+
+    bool pushed = ring.queue.try_push(std::move(record));
+    if (!pushed)
+    {
+        switch (m_async_config.overflow_policy)
+        {
+            case LogOverflowPolicy::BLOCK:
+                while (!(pushed = ring.queue.try_push(std::move(record))))
+                {
+                    m_writer_cv.notify_one();
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                }
+                break;
+            case LogOverflowPolicy::DROP:
+                break;
+            case LogOverflowPolicy::DROP_AND_COUNT:
+                ring.dropped.store(ring.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                break;
+        }
+    }
+    else if (ring.queue.size() >= ring.queue.capacity() / 2)
+    {
+        // Wake the writer early rather than let a burst hit the limit
+        m_writer_cv.notify_one();
+    }
+
+    ring.publishing.store(false, std::memory_order_release);
+    return true;
+}
+
+std::size_t Logger::drain_rings(std::vector<Record>& batch)
+{
+    std::vector<std::shared_ptr<ProducerRing>> rings;
+    {
+        std::lock_guard<std::mutex> lock(m_rings_mutex);
+        rings = m_rings;
+    }
+
+    batch.clear();
+    std::uint64_t dropped = 0;
+    for (const auto& ring : rings)
+    {
+        Record record;
+        while (ring->queue.try_pop(record)) batch.push_back(std::move(record));
+
+        const std::uint64_t total = ring->dropped.load(std::memory_order_relaxed);
+        dropped += total - ring->dropped_reported;
+        ring->dropped_reported = total;
+    }
+
+    // Interleave the threads' messages in timestamp order
+    std::stable_sort(batch.begin(), batch.end(),
+        [](const Record& a, const Record& b)
+        {
+            // Only one of the two clocks is set, unless the mode just changed
+            return a.time != b.time ? a.time < b.time : a.monotonic_ns < b.monotonic_ns;
+        });
+
+    if (dropped > 0)
+    {
+        m_dropped_total.fetch_add(dropped, std::memory_order_relaxed);
+        Record notice{ {}, LogLevel::WARNING, "Logger dropped " + std::to_string(dropped) + " messages (queue full)" };
+        notice.time = Clock::now();
+        batch.push_back(std::move(notice));
+    }
+
+    if (!batch.empty())
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        write_locked(batch.data(), batch.size());
+    }
+
+    // Forget the rings of exited threads once they are empty
+    {
+        std::lock_guard<std::mutex> lock(m_rings_mutex);
+        std::erase_if(m_rings, [](const std::shared_ptr<ProducerRing>& ring)
+        {
+            return ring->retired.load(std::memory_order_acquire) && ring->queue.empty();
+        });
+    }
+    return batch.size();
+}
+
+void Logger::writer_loop()
+{
+    t_writer_of = this;
+    std::vector<Record> batch;
+
+    std::unique_lock<std::mutex> lock(m_writer_mutex);
+    while (true)
+    {
+        m_writer_cv.wait_for(lock, m_async_config.flush_interval,
+            [this]() { return m_writer_stop || m_flush_requested > m_flush_completed; });
+
+        // Everything pushed before these were read is written below
+        const bool stopping = m_writer_stop;
+        const std::uint64_t flush_target = m_flush_requested;
+        const bool flush_requested = flush_target > m_flush_completed;
+
+        lock.unlock();
+        drain_rings(batch);
+        // Sinks with a lazy flush policy must still honour flush()
+        if (flush_requested || stopping) flush_sinks();
+        lock.lock();
+
+        m_flush_completed = flush_target;
+        m_flush_cv.notify_all();
+
+        if (stopping) break;
+    }
+}
+
+std::string Logger::format_line(Clock::time_point time, LogLevel level, const std::string& message)
+{
+    std::string line;
+    line.reserve(32 + message.size());
+    append_time_stamp(line, time);
+    line.append(" [").append(log_level_to_string(level)).append("] ").append(message);
+    return line;
+}
+
+std::string Logger::format_line(const Record& record)
+{
+    if (record.monotonic_ns < 0) return format_line(record.time, record.level, record.message);
+
+    char digits[24];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), record.monotonic_ns);
+
+    std::string line;
+    line.reserve(32 + record.message.size());
+    line.append(digits, result.ptr);
+    line.append(" [").append(log_level_to_string(record.level)).append("] ").append(record.message);
+    return line;
+}
+
+void Logger::append_time_stamp(std::string& out, Clock::time_point time) 
 {
     using namespace std::chrono;
-    const auto now = system_clock::now();
-    const auto t_time = system_clock::to_time_t(now);
-    const auto ms = duration_cast<milliseconds>(now.time_since_epoch()) % 1000;
 
-    std::ostringstream oss;
-    oss << std::put_time(std::localtime(&t_time), "%Y-%m-%d %H:%M:%S")
-        << '.' << std::setw(3) << std::setfill('0') << ms.count();
-    return oss.str();
+    // "YYYY-MM-DD HH:MM:SS" only changes once a second: render it with
+    // localtime_r/localtime_s on a new second, then patch the milliseconds
+    struct Cache
+    {
+        std::int64_t second             {std::numeric_limits<std::int64_t>::min()};
+        char text[32]                   {};
+        std::size_t length              {0};
+    };
+    thread_local Cache t_cache;
+
+    const std::int64_t ms_since_epoch = duration_cast<milliseconds>(time.time_since_epoch()).count();
+    std::int64_t second = ms_since_epoch / 1000;
+    std::int64_t millis = ms_since_epoch % 1000;
+    if (millis < 0)
+    {
+        millis += 1000;
+        --second;
+    }
+
+    if (second != t_cache.second)
+    {
+        const auto t_time = static_cast<std::time_t>(second);
+        std::tm local{};
+#if defined(ROBOTACT_PLATFORM_WINDOWS)
+        localtime_s(&local, &t_time);
+#else
+        localtime_r(&t_time, &local);
+#endif
+        t_cache.length = std::strftime(t_cache.text, sizeof(t_cache.text), "%Y-%m-%d %H:%M:%S.000", &local);
+        t_cache.second = second;
+    }
+
+    if (t_cache.length < 3) return;     // strftime failed, nothing sensible to print
+
+    char* const digits = t_cache.text + t_cache.length - 3;
+    digits[0] = static_cast<char>('0' + millis / 100);
+    digits[1] = static_cast<char>('0' + millis / 10 % 10);
+    digits[2] = static_cast<char>('0' + millis % 10);
+
+    out.append(t_cache.text, t_cache.length);
 }
 
 std::string Logger::log_level_to_string(LogLevel level) 
@@ -96,18 +513,4 @@ std::string Logger::log_level_to_string(LogLevel level)
     }
 }
 
-std::string Logger::log_level_to_color(LogLevel level) 
-{
-    switch (level) 
-    {
-        case LogLevel::TRACE:   return "\033[37m";       // White
-        case LogLevel::DEBUG:   return "\033[36m";       // Cyan
-        case LogLevel::INFO:    return "\033[32m";       // Green
-        case LogLevel::WARNING: return "\033[33m";       // Yellow
-        case LogLevel::ERROR:   return "\033[31m";       // Red
-        case LogLevel::FATAL:   return "\033[41m\033[97m"; // Red bg, White text
-        default:                return "\033[0m";        // Reset
-    }
-}
-
 } //namespace RoboTact::Core
\ No newline at end of file
@@ -6,9 +6,19 @@
  * 
  * Features:
  * - Thread-safe logging
- * - Multiple log levels (TRACE to FATAL)
+ * - Pluggable sinks (console, file, in-memory ring) with per-sink level
+ *   filters and flush policies
+ * - Multiple log levels (TRACE to FATAL), checked before the message
+ *   arguments are evaluated; levels below ROBOTACT_LOG_MIN_LEVEL are
+ *   compiled out
  * - Color-coded console output
- * - Timestamp precision to milliseconds
+ * - Timestamp precision to milliseconds, rendered from a per-thread
+ *   cache (or raw monotonic nanoseconds for high-rate streams)
+ * - Optional asynchronous mode: per-thread lock-free ring buffers drained
+ *   by a background writer thread
+ * - Optional binary capture of LOG_* calls (see binary_log.hpp)
+ * - Per-call-site rate limiting (LOG_*_EVERY_N / LOG_*_EVERY_MS) and
+ *   collapsing of repeated messages (see log_site.hpp)
  * - Interface-based design for testability
  */
 
@@ -21,24 +31,50 @@
 #include <iomanip>
 #include <memory>
 #include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "log_level.hpp"
+#include "log_format.hpp"
+#include "log_sink.hpp"
+#include "log_site.hpp"
+#include "binary_log.hpp"
 
 namespace RoboTact::Core
 {
 
 /**
- * @enum LogLevel
- * @brief Severity levels for log messages
- * 
- * Messages with lower severity than the current threshold will be filtered out.
+ * @enum LogOverflowPolicy
+ * @brief What an asynchronous log call does when its thread's ring is full
  */
-enum class LogLevel
+enum class LogOverflowPolicy
 {
-    TRACE,   
-    DEBUG,   
-    INFO,    
-    WARNING, 
-    ERROR,   
-    FATAL    
+    BLOCK,          ///< Wait for the writer to make room (no message is lost)
+    DROP,           ///< Discard the message silently
+    DROP_AND_COUNT  ///< Discard it and report the number of lost messages
+};
+
+/**
+ * @enum LogTimestampMode
+ * @brief How the time of a log line is rendered
+ */
+enum class LogTimestampMode
+{
+    WALL_CLOCK,     ///< Local "YYYY-MM-DD HH:MM:SS.mmm" (default)
+    MONOTONIC_NS    ///< steady_clock nanoseconds, cheaper and unambiguous at high rates
+};
+
+/**
+ * @struct AsyncLogConfig
+ * @brief Parameters of the asynchronous logging mode
+ */
+struct AsyncLogConfig
+{
+    std::size_t queue_capacity              {4096};     ///< Records per producer thread
+    LogOverflowPolicy overflow_policy       {LogOverflowPolicy::DROP_AND_COUNT};
+    std::chrono::milliseconds flush_interval{10};       ///< Writer wake-up period
 };
 
 /**
@@ -55,17 +91,39 @@ public:
 
     /**
      * @brief Initialize the logger
+     * 
+     * Replaces the sinks with a ConsoleSink and, if a file name is given,
+     * a FileSink.
+     * 
      * @param file_name Path to log file (emtpy for no file logging)
      * @param level Minimum severity level to log
      */
     virtual void init(const std::string& file_name, LogLevel level = LogLevel::INFO) = 0;
 
+    /**
+     * @brief Adds a destination; every record passing the logger's level
+     *        and the sink's own level is written to it
+     */
+    virtual void add_sink(std::shared_ptr<ILogSink> sink) = 0;
+
+    /**
+     * @brief Flushes and removes a destination added earlier
+     */
+    virtual void remove_sink(const std::shared_ptr<ILogSink>& sink) = 0;
+
     /**
      * @brief Set the minimum log level
      * @param level Message below this level will be filtered
      */
     virtual void set_log_level(LogLevel level) = 0; 
 
+    /**
+     * @brief Whether a message of this level would be logged
+     * 
+     * Cheap enough to call before building the message (see LOG_IMPL).
+     */
+    virtual bool should_log(LogLevel level) const noexcept = 0;
+
     /**
      * @brief Log a message with specified severity level
      * @param level Severity level of the message
@@ -74,38 +132,33 @@ public:
     virtual void log(LogLevel level, const std::string& message) = 0;
 
     /**
-     * @brief Converts a single argument to its string representation.
-     * 
-     * Uses stringstream to convert any streamable type into a std::string.
-     *
-     * @tparam T Type of the argument.
-     * @param arg The argument to convert.
-     * @return String representation of the argument.
-     */
-    template<typename T>
-    static std::string Format(T&& arg) 
-    {
-        std::ostringstream oss;
-        oss << std::forward<T>(arg);
-        return oss.str();
-    }
+     * @brief Blocks until every message logged so far has been written out
+     */
+    virtual void flush() = 0;
 
     /**
-     * @brief Recursively formats multiple arguments into a space-separated string.
+     * @brief Formats log arguments into one string in a single pass
      * 
-     * This function combines all arguments into a single string by converting each
-     * argument to a string and separating them with spaces.
+     * Accepts both the space-separated style ("Loaded", count, "meshes")
+     * and "{}" placeholders ("Loaded {} meshes", count); see log_format.hpp.
      * 
-     * @tparam T Type of the first argument.
-     * @tparam Args Types of the remaining arguments.
-     * @param arg The first argument.
-     * @param args Remaining arguments.
-     * @return A space-separated concatenated string representation of all arguments.
-     */
-    template<typename T, typename... Args>
-    static std::string Format(T&& arg, Args&&... args) 
+     * @tparam Args Types of the arguments (strings, numbers or any type
+     *         with an operator<<)
+     * @param args Arguments to format
+     * @return The formatted message
+     */
+    template<typename... Args>
+    static std::string Format(const Args&... args) 
     {
-        return Format(std::forward<T>(arg)) + " " + Format(std::forward<Args>(args)...);
+        if constexpr (sizeof...(Args) == 0)
+        {
+            return std::string();
+        }
+        else
+        {
+            const detail::FormatArg list[] = { detail::make_format_arg(args)... };
+            return detail::format_message(list, sizeof...(Args));
+        }
     }
 };
 
@@ -114,8 +167,8 @@ public:
  * @class Logger
  * @brief Concrete thread-safe logger implementation
  * 
- * Supports simultaneous console (with color) and file output with configurable
- * log level filtering.
+ * Formats each record once and fans it out to its sinks (console with
+ * color, files, in-memory ring, ...) with configurable level filtering.
  */
 class Logger final : public ILogger 
 {
@@ -145,16 +198,81 @@ public:
      */
     void init(const std::string& file_name, LogLevel level = LogLevel::INFO) override;
 
+    /**
+     * @copydoc ILogger::add_sink
+     */
+    void add_sink(std::shared_ptr<ILogSink> sink) override;
+
+    /**
+     * @copydoc ILogger::remove_sink
+     */
+    void remove_sink(const std::shared_ptr<ILogSink>& sink) override;
+
     /**
      * @copydoc ILogger::set_log_level
      */
     void set_log_level(LogLevel level) override;
 
+    /**
+     * @copydoc ILogger::should_log
+     */
+    bool should_log(LogLevel level) const noexcept override
+    {
+        return level >= m_log_level.load(std::memory_order_relaxed);
+    }
+
     /**
      * @copydoc ILogger::log
+     * 
+     * In asynchronous mode the message is queued with its timestamp and
+     * written by the writer thread; FATAL messages are written
+     * synchronously after everything queued before them. Messages
+     * logged by a sink are written after the line being written.
      */
     void log(LogLevel level, const std::string& message) override;
 
+    /**
+     * @copydoc ILogger::flush
+     */
+    void flush() override;
+
+    /**
+     * @brief Switches to asynchronous mode and starts the writer thread
+     * 
+     * Log calls then only copy the message into a ring buffer owned by
+     * the calling thread; timestamp/level formatting and all I/O happen
+     * on the writer thread. No-op if already asynchronous.
+     */
+    void start_async(AsyncLogConfig config = {});
+
+    /**
+     * @brief Writes out all queued messages and returns to synchronous mode
+     * 
+     * Called by the destructor, so nothing queued is lost at shutdown.
+     */
+    void stop_async();
+
+    [[nodiscard]] bool is_async() const noexcept { return m_async.load(); }
+
+    /**
+     * @brief Messages discarded by the DROP_AND_COUNT policy so far
+     */
+    [[nodiscard]] std::uint64_t dropped_count() const noexcept;
+
+    /**
+     * @copydoc LogTimestampMode
+     */
+    void set_timestamp_mode(LogTimestampMode mode) noexcept { m_timestamp_mode.store(mode); }
+    [[nodiscard]] LogTimestampMode get_timestamp_mode() const noexcept { return m_timestamp_mode.load(); }
+
+    /**
+     * @brief Renders a log line (timestamp, level, message) without color
+     * 
+     * Shared with the binary log decoder so both produce identical text.
+     */
+    static std::string format_line(std::chrono::system_clock::time_point time, LogLevel level,
+                                   const std::string& message);
+
     /**
      * @brief Logs a message composed from multiple arguments at the specified severity level.
      * 
@@ -172,40 +290,65 @@ public:
     void log(LogLevel level, Args&&... args)
     {
         // Early exit if message level is below threshold
-        if (level < m_log_level.load()) { return; }
-
-        // Format the log message
-        std::ostringstream oss;
-        oss << get_time_stamp() 
-            << " [" << log_level_to_string(level) << "] " 
-            << Format(std::forward<Args>(args)...);;
-
-
-        // Thread-safe output operations
-        std::lock_guard<std::mutex> lock(m_mutex);
-        
-        const std::string log_message = oss.str();
-        
-        // Colorized console output
-        std::cout << log_level_to_color(level) 
-                  << log_message 
-                  << "\033[0m" << std::endl; // Set back console color to default
-
-        // File output (if enabled)
-        if (m_log_file.is_open()) 
-        {
-            m_log_file << log_message << std::endl;
-        }
+        if (!should_log(level)) { return; }
+
+        // A const lvalue makes the string overload the exact match
+        const std::string message = Format(args...);
+        log(level, message);
     }
 
 private:
-    static std::string get_time_stamp();
+    using Clock = std::chrono::system_clock;
+
+    struct Record
+    {
+        Clock::time_point time;
+        LogLevel level          {LogLevel::INFO};
+        std::string message;
+        std::int64_t monotonic_ns {-1};     ///< Set instead of `time` in MONOTONIC_NS mode
+    };
+
+    struct ProducerRing;
+    struct ThreadRings;
+
+    static void append_time_stamp(std::string& out, Clock::time_point time);
+    static std::string format_line(const Record& record);
     static std::string log_level_to_string(LogLevel level);
-    static std::string log_level_to_color(LogLevel level);
 
-    std::ofstream m_log_file;          
+    void write_batch(const Record* records, std::size_t count);
+    void write_locked(const Record* records, std::size_t count);
+    void flush_sinks();
+    void write_sync(Record&& record);
+    bool try_enqueue(Record& record);
+    ProducerRing& thread_ring();
+    std::size_t drain_rings(std::vector<Record>& batch);
+    void writer_loop();
+
+    std::vector<std::shared_ptr<ILogSink>> m_sinks;     ///< Guarded by m_mutex
+    std::vector<Record> m_deferred;                     ///< Logged by a sink mid-write, guarded by m_mutex
     std::atomic<LogLevel> m_log_level; 
+    std::atomic<LogTimestampMode> m_timestamp_mode  {LogTimestampMode::WALL_CLOCK};
     std::mutex m_mutex;                
+
+    // Asynchronous mode
+    const std::uint64_t m_id                        {next_id()};    ///< Tells Logger instances apart per thread
+    std::atomic<bool> m_async                       {false};
+    AsyncLogConfig m_async_config;
+    std::thread m_writer;
+    std::mutex m_control_mutex;                     ///< Serializes start_async()/stop_async()
+
+    std::mutex m_rings_mutex;
+    std::vector<std::shared_ptr<ProducerRing>> m_rings;
+    std::atomic<std::uint64_t> m_dropped_total      {0};
+
+    std::mutex m_writer_mutex;
+    std::condition_variable m_writer_cv;            ///< Wakes the writer
+    std::condition_variable m_flush_cv;             ///< Signals completed flushes
+    std::uint64_t m_flush_requested                 {0};
+    std::uint64_t m_flush_completed                 {0};
+    bool m_writer_stop                              {false};
+
+    static std::uint64_t next_id() noexcept;
 };
 
 
@@ -219,8 +362,12 @@ class NullLogger final : public ILogger
 {
 public:
     void init(const std::string&, LogLevel) override {}
+    void add_sink(std::shared_ptr<ILogSink>) override {}
+    void remove_sink(const std::shared_ptr<ILogSink>&) override {}
     void set_log_level(LogLevel) override {}
+    bool should_log(LogLevel) const noexcept override { return false; }
     void log(LogLevel, const std::string&) override {}
+    void flush() override {}
 };
 
 // Convenience logging macros
@@ -229,13 +376,53 @@ public:
     return l; \
 }()
 
-#define LOG_IMPL(level, ...)                                     \
-    do {                                                         \
-        auto& logger = GET_LOGGER();                             \
-        logger.log(RoboTact::Core::LogLevel::level,              \
-                   RoboTact::Core::ILogger::Format(__VA_ARGS__));\
+/**
+ * Lowest level compiled in, as the LogLevel's integer value (0 = TRACE,
+ * 5 = FATAL). Calls below it compile to nothing; set for Release builds
+ * by CMake (ROBOTACT_RELEASE_LOG_MIN_LEVEL).
+ */
+#ifndef ROBOTACT_LOG_MIN_LEVEL
+#define ROBOTACT_LOG_MIN_LEVEL 0
+#endif
+
+// The arguments are only evaluated when the level passes both checks
+// and `limit` (which may use the site's state) holds. While a binary log
+// is open they are captured raw instead of formatted.
+#define LOG_SITE_IMPL(level, collapse, limit, ...)                                   \
+    do {                                                                             \
+        if constexpr (static_cast<int>(RoboTact::Core::LogLevel::level)              \
+                      >= ROBOTACT_LOG_MIN_LEVEL) {                                   \
+            static RoboTact::Core::detail::LogSite robotact_log_site(                \
+                __FILE__, __LINE__, RoboTact::Core::LogLevel::level, collapse);      \
+            auto& logger = GET_LOGGER();                                             \
+            if (logger.should_log(RoboTact::Core::LogLevel::level) && (limit)) {     \
+                if (RoboTact::Core::BinaryLog::is_active()) {                        \
+                    RoboTact::Core::BinaryLog::write([] {},                          \
+                        RoboTact::Core::LogLevel::level, __FILE__, __LINE__,         \
+                        __VA_ARGS__);                                                \
+                } else {                                                             \
+                    RoboTact::Core::detail::log_from_site(logger, robotact_log_site, \
+                        RoboTact::Core::ILogger::Format(__VA_ARGS__));               \
+                }                                                                    \
+            }                                                                        \
+        }                                                                            \
     } while (0)
 
+#define LOG_IMPL(level, ...) LOG_SITE_IMPL(level, false, true, __VA_ARGS__)
+
+// Count a message identical to the site's previous one instead of
+// logging it again (see log_site.hpp)
+#define LOG_COLLAPSED_IMPL(level, ...) LOG_SITE_IMPL(level, true, true, __VA_ARGS__)
+
+// Log the 1st, (n+1)th, (2n+1)th, ... call of the site
+#define LOG_EVERY_N_IMPL(level, n, ...) \
+    LOG_SITE_IMPL(level, false, robotact_log_site.every_n(n), __VA_ARGS__)
+
+// Log at most once per `ms` milliseconds; the next logged line reports
+// how many calls were skipped
+#define LOG_EVERY_MS_IMPL(level, ms, ...) \
+    LOG_SITE_IMPL(level, false, robotact_log_site.every_ms(ms), __VA_ARGS__)
+
 #define LOG_TRACE(...)   LOG_IMPL(TRACE, __VA_ARGS__)
 #define LOG_DEBUG(...)   LOG_IMPL(DEBUG, __VA_ARGS__)
 #define LOG_INFO(...)    LOG_IMPL(INFO, __VA_ARGS__)
@@ -243,6 +430,24 @@ public:
 #define LOG_ERROR(...)   LOG_IMPL(ERROR, __VA_ARGS__)
 #define LOG_FATAL(...)   LOG_IMPL(FATAL, __VA_ARGS__)
 
+#define LOG_TRACE_COLLAPSED(...)   LOG_COLLAPSED_IMPL(TRACE, __VA_ARGS__)
+#define LOG_DEBUG_COLLAPSED(...)   LOG_COLLAPSED_IMPL(DEBUG, __VA_ARGS__)
+#define LOG_INFO_COLLAPSED(...)    LOG_COLLAPSED_IMPL(INFO, __VA_ARGS__)
+#define LOG_WARNING_COLLAPSED(...) LOG_COLLAPSED_IMPL(WARNING, __VA_ARGS__)
+#define LOG_ERROR_COLLAPSED(...)   LOG_COLLAPSED_IMPL(ERROR, __VA_ARGS__)
+
+#define LOG_TRACE_EVERY_N(n, ...)   LOG_EVERY_N_IMPL(TRACE, n, __VA_ARGS__)
+#define LOG_DEBUG_EVERY_N(n, ...)   LOG_EVERY_N_IMPL(DEBUG, n, __VA_ARGS__)
+#define LOG_INFO_EVERY_N(n, ...)    LOG_EVERY_N_IMPL(INFO, n, __VA_ARGS__)
+#define LOG_WARNING_EVERY_N(n, ...) LOG_EVERY_N_IMPL(WARNING, n, __VA_ARGS__)
+#define LOG_ERROR_EVERY_N(n, ...)   LOG_EVERY_N_IMPL(ERROR, n, __VA_ARGS__)
+
+#define LOG_TRACE_EVERY_MS(ms, ...)   LOG_EVERY_MS_IMPL(TRACE, ms, __VA_ARGS__)
+#define LOG_DEBUG_EVERY_MS(ms, ...)   LOG_EVERY_MS_IMPL(DEBUG, ms, __VA_ARGS__)
+#define LOG_INFO_EVERY_MS(ms, ...)    LOG_EVERY_MS_IMPL(INFO, ms, __VA_ARGS__)
+#define LOG_WARNING_EVERY_MS(ms, ...) LOG_EVERY_MS_IMPL(WARNING, ms, __VA_ARGS__)
+#define LOG_ERROR_EVERY_MS(ms, ...)   LOG_EVERY_MS_IMPL(ERROR, ms, __VA_ARGS__)
+
 
 
 } // namespace RoboTact::Core
@@ -0,0 +1,344 @@
+#include "segmented_file_sink.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if defined(ROBOTACT_PLATFORM_LINUX) || defined(ROBOTACT_PLATFORM_MACOS)
+    #define ROBOTACT_SEGMENTED_LOG_MMAP 1
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace RoboTact::Core
+{
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    constexpr std::string_view SEGMENT_EXTENSION = ".log";
+    constexpr std::size_t MIN_SEGMENT_SIZE = 4096;
+    constexpr std::size_t INDEX_DIGITS = 6;
+
+    /**
+     * @brief Index of a "<base>.<index>.log" file name, if it is one
+     */
+    std::optional<std::uint64_t> parse_segment_index(const std::string& name, const std::string& base_name)
+    {
+        if (name.size() <= base_name.size() + 1 + SEGMENT_EXTENSION.size() ||
+            name.compare(0, base_name.size(), base_name) != 0 ||
+            name[base_name.size()] != '.' ||
+            !name.ends_with(SEGMENT_EXTENSION))
+        {
+            return std::nullopt;
+        }
+
+        const char* first = name.data() + base_name.size() + 1;
+        const char* last = name.data() + name.size() - SEGMENT_EXTENSION.size();
+        std::uint64_t index = 0;
+        const auto [ptr, error] = std::from_chars(first, last, index);
+        if (error != std::errc() || ptr != last) return std::nullopt;
+        return index;
+    }
+
+    /**
+     * @brief Segments of `base_name` in `directory`, oldest first
+     */
+    std::vector<std::pair<std::uint64_t, fs::path>> list_segments(const fs::path& directory,
+                                                                  const std::string& base_name)
+    {
+        std::vector<std::pair<std::uint64_t, fs::path>> segments;
+        std::error_code error;
+        for (const auto& entry : fs::directory_iterator(directory, error))
+        {
+            if (!entry.is_regular_file(error)) continue;
+            if (auto index = parse_segment_index(entry.path().filename().string(), base_name))
+            {
+                segments.emplace_back(*index, entry.path());
+            }
+        }
+        std::sort(segments.begin(), segments.end());
+        return segments;
+    }
+
+    /**
+     * @brief Cuts the zero padding and a torn last line off a segment the
+     *        writer never closed
+     * @return True if the segment needed repair
+     *
+     * Closed segments are truncated to their data and end with a newline,
+     * so a trailing zero byte means the process died while writing it.
+     */
+    bool recover_segment(const fs::path& path)
+    {
+        std::error_code error;
+        const std::uintmax_t size = fs::file_size(path, error);
+        if (error || size == 0) return false;
+
+        std::ifstream file(path, std::ios::binary);
+        char last = 0;
+        if (!file.seekg(static_cast<std::streamoff>(size - 1)) || !file.get(last) || last != '\0') return false;
+
+        // Keep everything up to the last complete line
+        constexpr std::uintmax_t BLOCK_SIZE = 64 * 1024;
+        std::vector<char> block(BLOCK_SIZE);
+        std::uintmax_t keep = 0;
+        for (std::uintmax_t end = size; end > 0 && keep == 0;)
+        {
+            const std::uintmax_t begin = end > BLOCK_SIZE ? end - BLOCK_SIZE : 0;
+            file.seekg(static_cast<std::streamoff>(begin));
+            if (!file.read(block.data(), static_cast<std::streamsize>(end - begin))) return false;
+
+            for (std::uintmax_t i = end - begin; i-- > 0;)
+            {
+                if (block[i] == '\n')
+                {
+                    keep = begin + i + 1;
+                    break;
+                }
+            }
+            end = begin;
+        }
+        file.close();
+
+        if (keep == 0)
+        {
+            fs::remove(path, error);
+        }
+        else
+        {
+            fs::resize_file(path, keep, error);
+        }
+        return true;
+    }
+}
+
+/**
+ * @brief One open segment file
+ */
+struct SegmentedFileSink::Segment
+{
+    fs::path path;
+    std::size_t capacity;
+    std::size_t used        {0};
+
+#if defined(ROBOTACT_SEGMENTED_LOG_MMAP)
+    int fd                  {-1};
+    char* data              {nullptr};
+    std::size_t synced      {0};    ///< Bytes already scheduled for write-back
+
+    Segment(fs::path segment_path, std::size_t segment_capacity)
+        : path(std::move(segment_path)), capacity(segment_capacity)
+    {
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "Failed to create log segment " + path.string());
+        }
+
+        // Reserving the blocks up front makes a full disk fail here instead
+        // of raising SIGBUS on a later write into the mapping
+#if defined(ROBOTACT_PLATFORM_LINUX)
+        const int result = ::posix_fallocate(fd, 0, static_cast<off_t>(capacity));
+#else
+        const int result = ::ftruncate(fd, static_cast<off_t>(capacity)) == 0 ? 0 : errno;
+#endif
+        void* mapping = result == 0
+            ? ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+            : MAP_FAILED;
+        if (mapping == MAP_FAILED)
+        {
+            const int mapping_error = result != 0 ? result : errno;
+            ::close(fd);
+            ::unlink(path.c_str());
+            throw std::system_error(mapping_error, std::generic_category(),
+                                    "Failed to preallocate log segment " + path.string());
+        }
+        data = static_cast<char*>(mapping);
+    }
+
+    ~Segment()
+    {
+        ::munmap(data, capacity);
+        // Drop the unused padding so the file reads as plain text
+        [[maybe_unused]] const int result = ::ftruncate(fd, static_cast<off_t>(used));
+        ::close(fd);
+    }
+
+    bool append(std::string_view line) noexcept
+    {
+        if (used + line.size() + 1 > capacity) return false;
+
+        // Plain stores into the page cache; the kernel writes them back,
+        // also if the process crashes
+        std::memcpy(data + used, line.data(), line.size());
+        data[used + line.size()] = '\n';
+        used += line.size() + 1;
+        return true;
+    }
+
+    void flush() noexcept
+    {
+        if (used == synced) return;
+
+        static const std::size_t page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        const std::size_t begin = synced - synced % page_size;
+        ::msync(data + begin, used - begin, MS_ASYNC);
+        synced = used;
+    }
+#else
+    std::ofstream file;
+
+    Segment(fs::path segment_path, std::size_t segment_capacity)
+        : path(std::move(segment_path)), capacity(segment_capacity)
+    {
+        file.open(path, std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Failed to create log segment " + path.string());
+        }
+    }
+
+    bool append(std::string_view line)
+    {
+        if (used + line.size() + 1 > capacity) return false;
+
+        file << line << '\n';
+        used += line.size() + 1;
+        return true;
+    }
+
+    void flush()
+    {
+        file.flush();
+    }
+#endif
+
+    Segment(const Segment&) = delete;
+    Segment& operator=(const Segment&) = delete;
+};
+
+SegmentedFileSink::SegmentedFileSink(SegmentedFileConfig config, LogSinkConfig sink_config)
+    : ILogSink(sink_config),
+      m_config(std::move(config)),
+      m_segment_size(std::max(m_config.segment_size, MIN_SEGMENT_SIZE))
+{
+    fs::create_directories(m_config.directory);
+
+    // Continue numbering after the newest segment left by earlier runs
+    for (const auto& [index, path] : list_segments(m_config.directory, m_config.base_name))
+    {
+        m_next_index = std::max(m_next_index, index + 1);
+        if (recover_segment(path))
+        {
+            ++m_recovered;
+        }
+    }
+
+    open_next_segment();
+}
+
+SegmentedFileSink::~SegmentedFileSink() = default;
+
+void SegmentedFileSink::write(LogLevel, std::string_view line)
+{
+    // A line longer than a whole segment is cut to fit
+    line = line.substr(0, m_segment_size - 1);
+
+    if (m_segment && m_config.max_segment_age.count() > 0 &&
+        std::chrono::steady_clock::now() - m_opened_at >= m_config.max_segment_age)
+    {
+        rotate();
+    }
+
+    if (m_segment && m_segment->append(line)) return;
+
+    rotate();
+    if (m_segment)
+    {
+        m_segment->append(line);
+    }
+}
+
+void SegmentedFileSink::flush()
+{
+    if (m_segment)
+    {
+        m_segment->flush();
+    }
+}
+
+std::filesystem::path SegmentedFileSink::current_segment() const
+{
+    return m_segment ? m_segment->path : std::filesystem::path();
+}
+
+void SegmentedFileSink::rotate()
+{
+    const auto now = std::chrono::steady_clock::now();
+    if (!m_segment && now < m_retry_at) return;
+
+    try
+    {
+        open_next_segment();
+    }
+    catch (const std::exception& e)
+    {
+        // Logging must not take the writer down; retry once a second
+        m_retry_at = now + std::chrono::seconds(1);
+        std::cerr << "Log segment rotation failed, file output paused: " << e.what() << '\n';
+    }
+}
+
+void SegmentedFileSink::open_next_segment()
+{
+    // Close (and trim) the current segment before making room for the next
+    m_segment.reset();
+
+    if (m_config.max_segments > 0)
+    {
+        enforce_retention(m_config.max_segments - 1);
+    }
+
+    m_segment = std::make_unique<Segment>(segment_path(m_next_index), m_segment_size);
+    ++m_next_index;
+    m_opened_at = std::chrono::steady_clock::now();
+}
+
+void SegmentedFileSink::enforce_retention(std::size_t keep) const
+{
+    auto segments = list_segments(m_config.directory, m_config.base_name);
+    if (segments.size() <= keep) return;
+
+    std::error_code error;
+    for (std::size_t i = 0; i < segments.size() - keep; ++i)
+    {
+        fs::remove(segments[i].second, error);
+    }
+}
+
+std::filesystem::path SegmentedFileSink::segment_path(std::uint64_t index) const
+{
+    char digits[24];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), index);
+    const auto length = static_cast<std::size_t>(result.ptr - digits);
+
+    std::string name = m_config.base_name;
+    name += '.';
+    name.append(INDEX_DIGITS - std::min(length, INDEX_DIGITS), '0');
+    name.append(digits, result.ptr);
+    name += SEGMENT_EXTENSION;
+    return m_config.directory / name;
+}
+
+} // namespace RoboTact::Core
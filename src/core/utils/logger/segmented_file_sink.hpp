@@ -0,0 +1,94 @@
+#ifndef SEGMENTED_FILE_SINK_HPP
+#define SEGMENTED_FILE_SINK_HPP
+
+/**
+ * @brief Log sink writing a rotating set of preallocated segment files
+ *
+ * Features:
+ * - Segments "<base>.<index>.log" preallocated to a fixed size and written
+ *   through a shared memory mapping: no syscall per line (POSIX); other
+ *   platforms fall back to a buffered file stream
+ * - Rotation when a segment is full or older than a maximum age
+ * - Retention: only the newest `max_segments` segments are kept
+ * - Crash recovery: a segment left padded by an unclean shutdown is cut
+ *   back to its last complete line at startup
+ *
+ * A closed segment is truncated to the bytes actually written, so only
+ * the segment in use carries zero padding.
+ */
+
+#include "log_sink.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace RoboTact::Core
+{
+
+/**
+ * @struct SegmentedFileConfig
+ * @brief Location, size and retention of log segments
+ */
+struct SegmentedFileConfig
+{
+    std::filesystem::path directory         {"logs"};
+    std::string base_name                   {"application"};
+    std::size_t segment_size                {16 * 1024 * 1024};     ///< Bytes preallocated per segment
+    std::chrono::seconds max_segment_age    {std::chrono::hours(1)};    ///< 0 = rotate on size only
+    std::size_t max_segments                {8};                    ///< Segments kept on disk (0 = unlimited)
+};
+
+/**
+ * @class SegmentedFileSink
+ * @brief Size/age-rotated, memory-mapped log files with bounded disk use
+ */
+class SegmentedFileSink final : public ILogSink
+{
+public:
+    /**
+     * @throws std::runtime_error If the directory or first segment cannot be created
+     */
+    explicit SegmentedFileSink(SegmentedFileConfig config = {}, LogSinkConfig sink_config = {});
+    ~SegmentedFileSink() override;
+
+    void write(LogLevel level, std::string_view line) override;
+
+    /**
+     * @brief Schedules write-back of the mapped pages (does not block)
+     */
+    void flush() override;
+
+    /**
+     * @return Path of the segment currently written (empty if none is open)
+     */
+    [[nodiscard]] std::filesystem::path current_segment() const;
+
+    /**
+     * @return Segments repaired at startup after an unclean shutdown
+     */
+    [[nodiscard]] std::size_t recovered_segments() const noexcept { return m_recovered; }
+
+private:
+    struct Segment;
+
+    void rotate();
+    void open_next_segment();
+    void enforce_retention(std::size_t keep) const;
+    [[nodiscard]] std::filesystem::path segment_path(std::uint64_t index) const;
+
+    const SegmentedFileConfig m_config;
+    const std::size_t m_segment_size;
+    std::unique_ptr<Segment> m_segment;
+    std::uint64_t m_next_index                          {0};
+    std::size_t m_recovered                             {0};
+    std::chrono::steady_clock::time_point m_opened_at;
+    std::chrono::steady_clock::time_point m_retry_at;   ///< After a failed open, lines are dropped until then
+};
+
+} // namespace RoboTact::Core
+
+#endif // SEGMENTED_FILE_SINK_HPP
@@ -0,0 +1,99 @@
+#ifndef SPSC_RING_BUFFER_HPP
+#define SPSC_RING_BUFFER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace RoboTact::Core
+{
+
+/**
+ * @class SpscRingBuffer
+ * @brief Bounded lock-free queue for exactly one producer and one consumer
+ *
+ * Each side keeps a private copy of the other side's index and only reloads
+ * the shared atomic when that copy says the ring is full (producer) or
+ * empty (consumer), so a steady stream costs one release store per push.
+ * Capacity is rounded up to a power of two.
+ */
+template<typename T>
+class SpscRingBuffer
+{
+public:
+    explicit SpscRingBuffer(std::size_t capacity)
+        : m_slots(std::bit_ceil(std::max<std::size_t>(capacity, 2))),
+          m_mask(m_slots.size() - 1)
+    {
+    }
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    /**
+     * @brief Producer side: appends `value` unless the ring is full
+     * @return false if full (`value` is left untouched)
+     */
+    template<typename U>
+    bool try_push(U&& value)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_cached_tail >= m_slots.size())
+        {
+            m_cached_tail = m_tail.load(std::memory_order_acquire);
+            if (head - m_cached_tail >= m_slots.size()) return false;
+        }
+
+        m_slots[head & m_mask] = std::forward<U>(value);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Consumer side: removes the oldest element
+     * @return false if empty
+     */
+    bool try_pop(T& out)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_cached_head)
+        {
+            m_cached_head = m_head.load(std::memory_order_acquire);
+            if (tail == m_cached_head) return false;
+        }
+
+        out = std::move(m_slots[tail & m_mask]);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Element count, exact only when called from either side
+     */
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_slots.size(); }
+
+private:
+    std::vector<T> m_slots;
+    const std::size_t m_mask;
+
+    // Producer line: own index plus its view of the consumer
+    alignas(64) std::atomic<std::size_t> m_head     {0};
+    std::size_t m_cached_tail                       {0};
+
+    // Consumer line: own index plus its view of the producer
+    alignas(64) std::atomic<std::size_t> m_tail     {0};
+    std::size_t m_cached_head                       {0};
+};
+
+} // namespace RoboTact::Core
+
+#endif // SPSC_RING_BUFFER_HPP
@@ -0,0 +1,68 @@
+#include "scratch_arena.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace RoboTact::Core
+{
+	ScratchArena& ScratchArena::current()
+	{
+	    thread_local ScratchArena arena;
+	    return arena;
+	}
+
+	ScratchArena::ScratchArena()
+	    : m_buffer(std::make_unique<std::byte[]>(CAPACITY)),
+	      m_resource(m_buffer.get(), CAPACITY, std::pmr::new_delete_resource())
+	{
+	}
+
+	ScratchArena::Scope::Scope()
+	    : m_arena(ScratchArena::current())
+	{
+	    ++m_arena.m_depth;
+	}
+
+	ScratchArena::Scope::~Scope()
+	{
+	    --m_arena.m_depth;
+	    m_arena.reset();
+	}
+
+	void ScratchArena::reset() noexcept
+	{
+	    if (m_depth != 0 || m_allocated == 0) return;
+
+	    m_high_water = std::max(m_high_water, m_allocated);
+	    m_allocated = 0;
+
+	    // Frees heap spill-over and rewinds to the start of the buffer
+	    m_resource.release();
+	}
+
+	void* ScratchArena::do_allocate(std::size_t bytes, std::size_t alignment)
+	{
+	    void* p = m_resource.allocate(bytes, alignment);
+	    m_allocated += bytes;
+
+	    const std::byte* begin = m_buffer.get();
+	    const auto* address = static_cast<const std::byte*>(p);
+	    const std::less<const std::byte*> before;
+	    if (before(address, begin) || !before(address, begin + CAPACITY))
+	    {
+	        ++m_overflows;
+	    }
+	    return p;
+	}
+
+	void ScratchArena::do_deallocate(void*, std::size_t, std::size_t)
+	{
+	    // Memory is reclaimed all at once by reset()
+	}
+
+	bool ScratchArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+	{
+	    return this == &other;
+	}
+
+} // namespace RoboTact::Core
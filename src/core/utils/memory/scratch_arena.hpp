@@ -0,0 +1,122 @@
+#ifndef SCRATCH_ARENA_HPP
+#define SCRATCH_ARENA_HPP
+
+/**
+ * @brief Thread-local bump allocator for short-lived task/frame data
+ *
+ * Features:
+ * - One fixed buffer per thread, allocated on first use
+ * - Bump allocation, deallocation is a no-op
+ * - Whole-arena reset at task / frame boundaries
+ * - std::pmr::memory_resource interface, so pmr containers opt in
+ *   without changing the rest of the code
+ *
+ * Usage:
+ * @code
+ * std::pmr::vector<Contact> contacts(&ScratchArena::current());
+ * std::pmr::string label("robot_", &ScratchArena::current());
+ * @endcode
+ *
+ * ThreadManager resets the arena after every task, after every
+ * start_thread() iteration and after every periodic tick; the main loop
+ * resets it once per frame. Scratch memory must therefore not outlive
+ * the task or frame that allocated it.
+ */
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+/**
+ * @def ROBOTACT_SCRATCH_ARENA_SIZE
+ * @brief Bytes of the per-thread scratch buffer
+ *
+ * Allocations beyond this spill to the heap until the next reset.
+ * Override from the build (see CMake option of the same name).
+ */
+#ifndef ROBOTACT_SCRATCH_ARENA_SIZE
+    #define ROBOTACT_SCRATCH_ARENA_SIZE (256 * 1024)
+#endif
+
+namespace RoboTact::Core
+{
+
+/**
+ * @class ScratchArena
+ * @brief Per-thread monotonic memory resource, reset at task/frame boundaries
+ */
+class ScratchArena final : public std::pmr::memory_resource
+{
+public:
+	static constexpr std::size_t CAPACITY = ROBOTACT_SCRATCH_ARENA_SIZE;
+
+	/**
+	 * @brief Arena of the calling thread (created on first use)
+	 */
+	static ScratchArena& current();
+
+	/**
+	 * @class Scope
+	 * @brief Marks a task/frame boundary; the arena resets when the
+	 *        outermost scope of the thread ends
+	 *
+	 * Scopes nest, so a task that helps run other tasks (e.g. while
+	 * waiting in parallel_for) keeps its own scratch data alive.
+	 */
+	class Scope
+	{
+	public:
+		Scope();
+		~Scope();
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		ScratchArena& m_arena;
+	};
+
+	ScratchArena(const ScratchArena&) = delete;
+	ScratchArena& operator=(const ScratchArena&) = delete;
+
+	/**
+	 * @brief Releases everything allocated so far
+	 *
+	 * No-op while a Scope is open on this thread.
+	 */
+	void reset() noexcept;
+
+	/**
+	 * @brief Bytes handed out since the last reset
+	 */
+	[[nodiscard]] std::size_t bytes_allocated() const noexcept { return m_allocated; }
+
+	/**
+	 * @brief Largest bytes_allocated() seen at a reset
+	 */
+	[[nodiscard]] std::size_t high_water_mark() const noexcept { return m_high_water; }
+
+	/**
+	 * @brief Allocations that did not fit the buffer and went to the heap
+	 */
+	[[nodiscard]] std::size_t overflow_count() const noexcept { return m_overflows; }
+
+private:
+	ScratchArena();
+
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+	void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+	std::unique_ptr<std::byte[]> m_buffer;
+	std::pmr::monotonic_buffer_resource m_resource;
+
+	std::size_t m_depth 		{0};
+	std::size_t m_allocated 	{0};
+	std::size_t m_high_water 	{0};
+	std::size_t m_overflows 	{0};
+};
+
+} // namespace RoboTact::Core
+
+#endif // SCRATCH_ARENA_HPP
@@ -0,0 +1,276 @@
+#include "profiler.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+namespace RoboTact::Core
+{
+
+namespace
+{
+    constexpr std::uint64_t RING_MASK = Profiler::EVENTS_PER_THREAD - 1;
+
+    /**
+     * @brief One finished zone; atomics so export can read a ring that
+     *        its thread keeps overwriting (relaxed, plain moves on x86)
+     */
+    struct Event
+    {
+        std::atomic<const char*> name           {nullptr};
+        std::atomic<std::int64_t> begin         {0};    ///< Profiler::now_ticks()
+        std::atomic<std::int64_t> end           {0};
+    };
+
+    /**
+     * @brief Ring of one thread; written only by that thread
+     */
+    struct ThreadBuffer
+    {
+        std::uint32_t id                        {0};
+        std::string name;                       ///< Guarded by the registry mutex
+        std::unique_ptr<Event[]> storage;       ///< Allocated by the owner on its first zone
+        std::atomic<Event*> events              {nullptr};
+        std::atomic<std::uint64_t> written      {0};    ///< Zones recorded so far (slot = index & RING_MASK)
+    };
+
+    struct Registry
+    {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;     ///< Kept after their thread exits
+        // Capture bounds, as ticks and as steady_clock ns (guarded by mutex)
+        std::int64_t start_ticks                {0};
+        std::int64_t start_ns                   {0};
+        std::int64_t stop_ticks                 {std::numeric_limits<std::int64_t>::max()};
+        std::int64_t stop_ns                    {0};
+    };
+
+    std::int64_t steady_now_ns() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    Registry& registry()
+    {
+        // Never destroyed: threads may still end zones during static destruction
+        static Registry* const instance = new Registry();
+        return *instance;
+    }
+
+    thread_local ThreadBuffer* t_buffer = nullptr;
+
+    ThreadBuffer& thread_buffer()
+    {
+        if (!t_buffer)
+        {
+            auto& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            auto buffer = std::make_unique<ThreadBuffer>();
+            buffer->id = static_cast<std::uint32_t>(reg.buffers.size() + 1);
+            buffer->name = "thread " + std::to_string(buffer->id);
+            t_buffer = buffer.get();
+            reg.buffers.push_back(std::move(buffer));
+        }
+        return *t_buffer;
+    }
+
+    struct ExportedZone
+    {
+        const char* name;
+        std::int64_t begin;
+        std::int64_t end;
+        std::uint64_t index;
+    };
+
+    /**
+     * @brief Copies the zones of one ring that survived the copy intact
+     */
+    void copy_ring(const ThreadBuffer& buffer, std::vector<ExportedZone>& zones)
+    {
+        zones.clear();
+        const Event* events = buffer.events.load(std::memory_order_acquire);
+        if (!events) return;
+
+        const std::uint64_t written = buffer.written.load(std::memory_order_acquire);
+        const std::uint64_t first = written > Profiler::EVENTS_PER_THREAD ? written - Profiler::EVENTS_PER_THREAD : 0;
+        for (std::uint64_t index = first; index < written; ++index)
+        {
+            const Event& event = events[index & RING_MASK];
+            zones.push_back({ event.name.load(std::memory_order_relaxed),
+                              event.begin.load(std::memory_order_relaxed),
+                              event.end.load(std::memory_order_relaxed),
+                              index });
+        }
+
+        // Pairs with the fence in record(): a slot read above while being
+        // overwritten shows up as a higher write count here
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const std::uint64_t written_after = buffer.written.load(std::memory_order_relaxed);
+        std::erase_if(zones, [written_after](const ExportedZone& zone)
+        {
+            return zone.index + Profiler::EVENTS_PER_THREAD <= written_after;
+        });
+    }
+
+    void write_json_string(std::ostream& out, std::string_view text)
+    {
+        static constexpr char HEX[] = "0123456789abcdef";
+
+        out << '"';
+        for (const char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                out << '\\' << c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                out << "\\u00" << HEX[(c >> 4) & 0xF] << HEX[c & 0xF];
+            }
+            else
+            {
+                out << c;
+            }
+        }
+        out << '"';
+    }
+
+    /**
+     * @brief Writes nanoseconds as the microseconds Chrome traces expect
+     */
+    void write_microseconds(std::ostream& out, std::int64_t ns)
+    {
+        const char fraction[] = { static_cast<char>('0' + ns % 1000 / 100),
+                                  static_cast<char>('0' + ns % 100 / 10),
+                                  static_cast<char>('0' + ns % 10), '\0' };
+        out << ns / 1000 << '.' << fraction;
+    }
+}
+
+void Profiler::start()
+{
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.start_ticks = now_ticks();
+    reg.start_ns = steady_now_ns();
+    reg.stop_ticks = std::numeric_limits<std::int64_t>::max();
+    s_active.store(true, std::memory_order_relaxed);
+}
+
+void Profiler::stop()
+{
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    if (!s_active.exchange(false, std::memory_order_relaxed)) return;
+    reg.stop_ticks = now_ticks();
+    reg.stop_ns = steady_now_ns();
+}
+
+void Profiler::set_thread_name(std::string_view name)
+{
+    ThreadBuffer& buffer = thread_buffer();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    buffer.name.assign(name);
+}
+
+void Profiler::record(const char* name, std::int64_t begin_ticks, std::int64_t end_ticks) noexcept
+{
+    ThreadBuffer* buffer = t_buffer;
+    Event* events = buffer ? buffer->events.load(std::memory_order_relaxed) : nullptr;
+    if (!events)
+    {
+        // First zone of this thread
+        try {
+            buffer = &thread_buffer();
+            buffer->storage = std::make_unique<Event[]>(EVENTS_PER_THREAD);
+        } catch (const std::exception&) {
+            return;
+        }
+        events = buffer->storage.get();
+        buffer->events.store(events, std::memory_order_release);
+    }
+
+    const std::uint64_t index = buffer->written.load(std::memory_order_relaxed);
+    Event& event = events[index & RING_MASK];
+
+    // Orders the previous count before the slot writes (see copy_ring)
+    std::atomic_thread_fence(std::memory_order_release);
+    event.name.store(name, std::memory_order_relaxed);
+    event.begin.store(begin_ticks, std::memory_order_relaxed);
+    event.end.store(end_ticks, std::memory_order_relaxed);
+    buffer->written.store(index + 1, std::memory_order_release);
+}
+
+std::size_t Profiler::write_chrome_trace(std::ostream& out)
+{
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    const std::int64_t stop_ticks = reg.stop_ticks;
+
+    // Tick rate from the capture bounds (or from now, while still running)
+    const bool running = stop_ticks == std::numeric_limits<std::int64_t>::max();
+    const std::int64_t end_ticks = running ? now_ticks() : stop_ticks;
+    const std::int64_t end_ns = running ? steady_now_ns() : reg.stop_ns;
+    const double ns_per_tick = end_ticks > reg.start_ticks
+        ? static_cast<double>(end_ns - reg.start_ns) / static_cast<double>(end_ticks - reg.start_ticks)
+        : 1.0;
+    const auto to_ns = [ns_per_tick](std::int64_t ticks)
+    {
+        return static_cast<std::int64_t>(static_cast<double>(ticks) * ns_per_tick);
+    };
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    out << "\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"RoboTact\"}}";
+
+    std::size_t exported = 0;
+    std::vector<ExportedZone> zones;
+    for (const auto& buffer : reg.buffers)
+    {
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id << ",\"args\":{\"name\":";
+        write_json_string(out, buffer->name);
+        out << "}}";
+
+        copy_ring(*buffer, zones);
+        for (const ExportedZone& zone : zones)
+        {
+            if (zone.begin < reg.start_ticks || zone.end > stop_ticks) continue;
+
+            out << ",\n{\"name\":";
+            write_json_string(out, zone.name);
+            out << ",\"cat\":\"zone\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->id << ",\"ts\":";
+            write_microseconds(out, to_ns(zone.begin - reg.start_ticks));
+            out << ",\"dur\":";
+            write_microseconds(out, to_ns(zone.end - zone.begin));
+            out << '}';
+            ++exported;
+        }
+    }
+
+    out << "\n]}\n";
+    return exported;
+}
+
+std::size_t Profiler::write_chrome_trace(const std::string& path)
+{
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Failed to open profiler trace file: " + path);
+    }
+
+    const std::size_t exported = write_chrome_trace(file);
+    file.flush();
+    if (!file)
+    {
+        throw std::runtime_error("Failed to write profiler trace file: " + path);
+    }
+    return exported;
+}
+
+} // namespace RoboTact::Core
@@ -0,0 +1,185 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+/**
+ * @brief Scoped CPU zone profiler with Chrome trace / Perfetto export
+ *
+ * Features:
+ * - PROFILE_SCOPE("name") times the enclosing block; zones nest
+ * - Each thread records into its own fixed ring of recent zones (no
+ *   locks, no allocation after the first zone of the thread); a zone
+ *   costs two timestamp reads and one ring write
+ * - Export as Chrome trace JSON, viewable in chrome://tracing or
+ *   ui.perfetto.dev
+ * - Compiled in only with ROBOTACT_ENABLE_PROFILER (CMake option of the
+ *   same name); otherwise the macros expand to nothing
+ *
+ * Usage:
+ * @code
+ * Profiler::start();
+ * {
+ *     PROFILE_SCOPE("physics");
+ *     step_physics();
+ * }
+ * Profiler::stop();
+ * Profiler::write_chrome_trace("trace.json");
+ * @endcode
+ *
+ * Zone names are stored as pointers, so they must be string literals
+ * (or otherwise outlive the export).
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+/**
+ * @def ROBOTACT_PROFILER_EVENTS_PER_THREAD
+ * @brief Zones kept per thread; older ones are overwritten (power of two)
+ */
+#ifndef ROBOTACT_PROFILER_EVENTS_PER_THREAD
+    #define ROBOTACT_PROFILER_EVENTS_PER_THREAD (64 * 1024)
+#endif
+
+namespace RoboTact::Core
+{
+
+/**
+ * @class Profiler
+ * @brief Process-wide capture control and export (static, like BinaryLog)
+ */
+class Profiler
+{
+public:
+    static constexpr std::size_t EVENTS_PER_THREAD = ROBOTACT_PROFILER_EVENTS_PER_THREAD;
+    static_assert((EVENTS_PER_THREAD & (EVENTS_PER_THREAD - 1)) == 0, "Profiler ring size must be a power of two");
+
+    Profiler() = delete;
+
+    /**
+     * @brief Whether PROFILE_* macros were compiled in
+     */
+    static constexpr bool is_enabled() noexcept
+    {
+#if defined(ROBOTACT_ENABLE_PROFILER)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Starts a capture; zones that ended before it are not exported
+     */
+    static void start();
+
+    /**
+     * @brief Stops recording; the capture can still be exported
+     */
+    static void stop();
+
+    [[nodiscard]] static bool is_active() noexcept { return s_active.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Names the calling thread in exported traces
+     */
+    static void set_thread_name(std::string_view name);
+
+    /**
+     * @brief Writes the zones of the current (or last) capture as Chrome
+     *        trace JSON
+     *
+     * Safe while threads are still recording: zones overwritten during
+     * the export are left out.
+     *
+     * @return Number of exported zones
+     */
+    static std::size_t write_chrome_trace(std::ostream& out);
+
+    /**
+     * @throws std::runtime_error If the file cannot be written
+     */
+    static std::size_t write_chrome_trace(const std::string& path);
+
+    /**
+     * @brief Zone timestamp: the TSC on x86 (a clock read costs about as
+     *        much as the rest of a zone), steady_clock ns elsewhere
+     *
+     * Converted to nanoseconds at export, against steady_clock samples
+     * taken at start() and stop().
+     */
+    static std::int64_t now_ticks() noexcept
+    {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        return static_cast<std::int64_t>(__rdtsc());
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        return static_cast<std::int64_t>(__builtin_ia32_rdtsc());
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    /**
+     * @brief Appends one finished zone to the calling thread's ring
+     */
+    static void record(const char* name, std::int64_t begin_ticks, std::int64_t end_ticks) noexcept;
+
+private:
+    static inline std::atomic<bool> s_active {false};
+};
+
+/**
+ * @class ProfileZone
+ * @brief Times its own lifetime (use through PROFILE_SCOPE)
+ */
+class ProfileZone
+{
+public:
+    explicit ProfileZone(const char* name) noexcept
+        : m_name(Profiler::is_active() ? name : nullptr),
+          m_begin(m_name ? Profiler::now_ticks() : 0)
+    {
+    }
+
+    ~ProfileZone()
+    {
+        if (m_name)
+        {
+            Profiler::record(m_name, m_begin, Profiler::now_ticks());
+        }
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* m_name;
+    std::int64_t m_begin;
+};
+
+} // namespace RoboTact::Core
+
+#define ROBOTACT_PROFILE_CONCAT_IMPL(a, b) a##b
+#define ROBOTACT_PROFILE_CONCAT(a, b) ROBOTACT_PROFILE_CONCAT_IMPL(a, b)
+
+#if defined(ROBOTACT_ENABLE_PROFILER)
+    #define PROFILE_SCOPE(name) \
+        const RoboTact::Core::ProfileZone ROBOTACT_PROFILE_CONCAT(robotact_profile_zone_, __LINE__)(name)
+    #define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
+    #define PROFILE_THREAD(name) RoboTact::Core::Profiler::set_thread_name(name)
+#else
+    #define PROFILE_SCOPE(name) static_cast<void>(0)
+    #define PROFILE_FUNCTION() static_cast<void>(0)
+    #define PROFILE_THREAD(name) static_cast<void>(0)
+#endif
+
+#endif // PROFILER_HPP
@@ -0,0 +1,128 @@
+#ifndef CANCELLATION_HPP
+#define CANCELLATION_HPP
+
+/**
+ * @brief Cooperative cancellation for ThreadManager tasks
+ *
+ * A CancellationSource owns the cancel flag, CancellationTokens observe
+ * it. Tasks enqueued with a token (or a deadline) are dropped when they
+ * are dequeued after cancellation/expiry, and their futures fail with
+ * TaskCancelled. Long-running tasks can also poll the token themselves.
+ *
+ * Usage:
+ * @code
+ * CancellationSource planning;
+ * ThreadManager::TaskOptions options;
+ * options.token = planning.token();
+ * options.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(50);
+ *
+ * auto path = thread_manager->submit(options, plan_path, goal);
+ * ...
+ * planning.cancel();   // superseded by a newer request
+ * @endcode
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+
+namespace RoboTact::Core
+{
+
+/**
+ * @class TaskCancelled
+ * @brief Stored in the future of a task dropped by cancellation or deadline
+ */
+class TaskCancelled : public std::runtime_error
+{
+public:
+	explicit TaskCancelled(const char* reason) : std::runtime_error(reason) {}
+};
+
+/**
+ * @class CancellationToken
+ * @brief Read-only view of a CancellationSource (cheap to copy)
+ *
+ * A default-constructed token is never cancelled.
+ */
+class CancellationToken
+{
+public:
+	CancellationToken() noexcept = default;
+
+	[[nodiscard]] bool is_cancelled() const noexcept
+	{
+		return m_flag && m_flag->load(std::memory_order_acquire);
+	}
+
+	[[nodiscard]] bool can_be_cancelled() const noexcept { return m_flag != nullptr; }
+
+	/**
+	 * @throws TaskCancelled if cancellation was requested
+	 */
+	void throw_if_cancelled() const
+	{
+		if (is_cancelled()) throw TaskCancelled("task cancelled");
+	}
+
+private:
+	friend class CancellationSource;
+
+	explicit CancellationToken(std::shared_ptr<const std::atomic<bool>> flag) noexcept
+		: m_flag(std::move(flag)) {}
+
+	std::shared_ptr<const std::atomic<bool>> m_flag;
+};
+
+/**
+ * @class CancellationSource
+ * @brief Issues tokens and requests cancellation of everything holding them
+ */
+class CancellationSource
+{
+public:
+	CancellationSource() : m_flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+	[[nodiscard]] CancellationToken token() const noexcept { return CancellationToken(m_flag); }
+
+	/**
+	 * @brief Requests cancellation (idempotent, thread-safe)
+	 */
+	void cancel() noexcept { m_flag->store(true, std::memory_order_release); }
+
+	[[nodiscard]] bool is_cancelled() const noexcept { return m_flag->load(std::memory_order_acquire); }
+
+private:
+	std::shared_ptr<std::atomic<bool>> m_flag;
+};
+
+namespace detail
+{
+	/**
+	 * @brief Cancellation/deadline check carried by a queued task
+	 */
+	struct TaskGuard
+	{
+		using Clock = std::chrono::steady_clock;
+
+		CancellationToken token;
+		Clock::time_point deadline 		{Clock::time_point::max()};
+
+		/**
+		 * @param now Returns the current time; only called if a deadline is set
+		 * @return Reason the task must be dropped, nullptr if it may run
+		 */
+		template<typename Now>
+		[[nodiscard]] const char* expired(Now&& now) const noexcept
+		{
+			if (token.is_cancelled()) return "task cancelled";
+			if (deadline != Clock::time_point::max() && now() >= deadline) return "task deadline expired";
+			return nullptr;
+		}
+	};
+} // namespace detail
+
+} // namespace RoboTact::Core
+
+#endif // CANCELLATION_HPP
@@ -0,0 +1,241 @@
+#ifndef COMPLETION_HANDLE_HPP
+#define COMPLETION_HANDLE_HPP
+
+#include "cancellation.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <type_traits>
+#include <utility>
+
+namespace RoboTact::Core
+{
+
+namespace detail
+{
+	/**
+	 * @class CompletionState
+	 * @brief Shared countdown behind a CompletionHandle
+	 *
+	 * One reference is held by the handle and one by every outstanding
+	 * task, so the state (and the body stored by derived classes) lives
+	 * exactly as long as somebody can still touch it.
+	 */
+	class CompletionState
+	{
+	public:
+		explicit CompletionState(std::size_t count) noexcept
+			: m_refs(1 + count), m_remaining(count) {}
+
+		virtual ~CompletionState() = default;
+
+		CompletionState(const CompletionState&) = delete;
+		CompletionState& operator=(const CompletionState&) = delete;
+
+		void release() noexcept
+		{
+			if (m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				delete this;
+			}
+		}
+
+		/**
+		 * @brief Records one finished task and drops its reference
+		 */
+		void complete_one() noexcept
+		{
+			if (m_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				m_remaining.notify_all();
+			}
+			release();
+		}
+
+		/**
+		 * @brief Keeps the first exception; later ones are dropped
+		 */
+		void capture_exception() noexcept { fail(std::current_exception()); }
+
+		void fail(std::exception_ptr error) noexcept
+		{
+			bool expected = false;
+			if (m_failed.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+			{
+				m_exception = std::move(error);
+			}
+		}
+
+		[[nodiscard]] std::size_t remaining() const noexcept
+		{
+			return m_remaining.load(std::memory_order_acquire);
+		}
+
+		void wait() const noexcept
+		{
+			std::size_t left;
+			while ((left = m_remaining.load(std::memory_order_acquire)) != 0)
+			{
+				m_remaining.wait(left, std::memory_order_acquire);
+			}
+		}
+
+		/**
+		 * @brief Only meaningful once remaining() reached zero
+		 */
+		[[nodiscard]] const std::exception_ptr& exception() const noexcept { return m_exception; }
+
+	private:
+		std::atomic<std::size_t> m_refs;
+		std::atomic<std::size_t> m_remaining;
+		std::atomic<bool> m_failed 		{false};
+		std::exception_ptr m_exception;
+	};
+
+	/**
+	 * @brief CompletionState that also owns the per-item body of a bulk enqueue
+	 */
+	template<typename Body>
+	class BulkState final : public CompletionState
+	{
+	public:
+		template<typename B>
+		BulkState(std::size_t count, B&& body)
+			: CompletionState(count), m_body(std::forward<B>(body)) {}
+
+		template<typename Item>
+		void run(Item&& item) noexcept
+		{
+			try {
+				m_body(std::forward<Item>(item));
+			} catch (...) {
+				capture_exception();
+			}
+			complete_one();
+		}
+
+		/**
+		 * @brief Settles an item that will never run
+		 */
+		void cancel_one() noexcept
+		{
+			fail(std::make_exception_ptr(TaskCancelled("ThreadManager stopped before the task ran")));
+			complete_one();
+		}
+
+	private:
+		Body m_body;
+	};
+
+	/**
+	 * @brief Adapts a per-element body to the iterators enqueue_range() queues
+	 */
+	template<typename Body>
+	struct DereferenceBody
+	{
+		Body body;
+
+		template<typename It>
+		void operator()(It& it) { body(*it); }
+	};
+
+	/**
+	 * @brief Queued task running one item of a BulkState
+	 *
+	 * Owns one reference of the state: a task destroyed without running
+	 * (emergency stop, shutdown) cancels its item, so the handle still
+	 * completes and the state is freed.
+	 */
+	template<typename State, typename Item>
+	class BulkTask
+	{
+	public:
+		BulkTask(State* state, Item item) noexcept(std::is_nothrow_move_constructible_v<Item>)
+			: m_state(state), m_item(std::move(item)) {}
+
+		BulkTask(BulkTask&& other) noexcept(std::is_nothrow_move_constructible_v<Item>)
+			: m_state(std::exchange(other.m_state, nullptr)), m_item(std::move(other.m_item)) {}
+
+		BulkTask& operator=(BulkTask&&) = delete;
+
+		~BulkTask() { if (m_state) m_state->cancel_one(); }
+
+		void operator()() noexcept { std::exchange(m_state, nullptr)->run(m_item); }
+
+	private:
+		State* m_state;
+		Item m_item;
+	};
+} // namespace detail
+
+/**
+ * @class CompletionHandle
+ * @brief Single handle tracking a whole batch of enqueued tasks
+ *
+ * Returned by ThreadManager::enqueue_bulk(), so fan-out code waits on
+ * one countdown instead of holding one future per item. Dropping the
+ * handle does not cancel anything; the tasks still run. Tasks the pool
+ * drops on stop complete the handle with TaskCancelled.
+ */
+class CompletionHandle
+{
+public:
+	CompletionHandle() noexcept = default;
+	explicit CompletionHandle(detail::CompletionState* state) noexcept : m_state(state) {}
+
+	CompletionHandle(CompletionHandle&& other) noexcept
+		: m_state(std::exchange(other.m_state, nullptr)) {}
+
+	CompletionHandle& operator=(CompletionHandle&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (m_state) m_state->release();
+			m_state = std::exchange(other.m_state, nullptr);
+		}
+		return *this;
+	}
+
+	CompletionHandle(const CompletionHandle&) = delete;
+	CompletionHandle& operator=(const CompletionHandle&) = delete;
+
+	~CompletionHandle() { if (m_state) m_state->release(); }
+
+	[[nodiscard]] bool valid() const noexcept { return m_state != nullptr; }
+
+	/**
+	 * @brief true once every task of the batch has finished
+	 */
+	[[nodiscard]] bool is_done() const noexcept { return !m_state || m_state->remaining() == 0; }
+
+	/**
+	 * @brief Number of tasks that have not finished yet
+	 */
+	[[nodiscard]] std::size_t remaining() const noexcept { return m_state ? m_state->remaining() : 0; }
+
+	/**
+	 * @brief Blocks until every task of the batch has finished
+	 *
+	 * From inside a pool task, poll is_done() and help with
+	 * ThreadManager::try_run_pending_task() instead of blocking.
+	 */
+	void wait() const noexcept { if (m_state) m_state->wait(); }
+
+	/**
+	 * @brief wait(), then rethrows the first exception thrown by any task
+	 */
+	void get() const
+	{
+		if (!m_state) return;
+		m_state->wait();
+		if (m_state->exception()) std::rethrow_exception(m_state->exception());
+	}
+
+private:
+	detail::CompletionState* m_state 	{nullptr};
+};
+
+} // namespace RoboTact::Core
+
+#endif // COMPLETION_HANDLE_HPP
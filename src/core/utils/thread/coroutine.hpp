@@ -0,0 +1,369 @@
+#ifndef COROUTINE_HPP
+#define COROUTINE_HPP
+
+/**
+ * @brief C++20 coroutine support on top of ThreadManager
+ *
+ * Features:
+ * - AsyncTask<T>: lazily started, awaitable coroutine with a result
+ * - co_await on(lane): continue on a pool worker through a priority lane
+ * - co_await sleep_for(d): timed resumption via the TimerWheel,
+ *   no thread is blocked while the coroutine waits
+ * - spawn(): start an AsyncTask on the pool and get a TaskFuture back
+ * - after stop_all(), pending and new co_awaits on the pool throw
+ *   TaskCancelled, which reaches the spawn() future
+ *
+ * Usage:
+ * @code
+ * AsyncTask<Mesh> load_mesh(std::string path)
+ * {
+ *     co_await on(ThreadManager::ThreadType::IO);
+ *     auto bytes = read_file(path);
+ *     co_await sleep_for(std::chrono::milliseconds(5));
+ *     co_return parse_mesh(bytes);
+ * }
+ *
+ * AsyncTask<> load_scene()
+ * {
+ *     Mesh robot = co_await load_mesh("robot.obj");
+ *     ...
+ * }
+ *
+ * spawn(*thread_manager, load_scene());
+ * @endcode
+ */
+
+#include "thread_manager.hpp"
+
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace RoboTact::Core
+{
+
+template<typename T = void>
+class AsyncTask;
+
+namespace detail
+{
+	struct AsyncPromiseBase
+	{
+		struct FinalAwaiter
+		{
+			bool await_ready() const noexcept { return false; }
+
+			template<typename Promise>
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+			{
+				// Symmetric transfer back to whoever awaited us
+				return handle.promise().continuation;
+			}
+
+			void await_resume() const noexcept {}
+		};
+
+		std::suspend_always initial_suspend() const noexcept { return {}; }
+		FinalAwaiter final_suspend() const noexcept { return {}; }
+		void unhandled_exception() noexcept { exception = std::current_exception(); }
+
+		std::coroutine_handle<> continuation = std::noop_coroutine();
+		std::exception_ptr exception;
+	};
+
+	template<typename T>
+	struct AsyncPromise : AsyncPromiseBase
+	{
+		AsyncTask<T> get_return_object() noexcept;
+
+		template<typename U>
+		void return_value(U&& value) { result.emplace(std::forward<U>(value)); }
+
+		T take()
+		{
+			if (exception) std::rethrow_exception(exception);
+			return std::move(*result);
+		}
+
+		std::optional<T> result;
+	};
+
+	template<>
+	struct AsyncPromise<void> : AsyncPromiseBase
+	{
+		AsyncTask<void> get_return_object() noexcept;
+
+		void return_void() const noexcept {}
+
+		void take() const
+		{
+			if (exception) std::rethrow_exception(exception);
+		}
+	};
+
+	/**
+	 * @brief Self-destroying coroutine used by spawn()
+	 */
+	struct DetachedTask
+	{
+		struct promise_type
+		{
+			DetachedTask get_return_object() noexcept
+			{
+				return DetachedTask{ std::coroutine_handle<promise_type>::from_promise(*this) };
+			}
+			std::suspend_always initial_suspend() const noexcept { return {}; }
+			std::suspend_never final_suspend() const noexcept { return {}; }
+			void return_void() const noexcept {}
+			void unhandled_exception() const noexcept { std::terminate(); }
+		};
+
+		std::coroutine_handle<promise_type> handle;
+	};
+} // namespace detail
+
+/**
+ * @class AsyncTask
+ * @brief Lazily started coroutine producing a T
+ *
+ * Starts when first awaited (or when passed to spawn()) and resumes its
+ * awaiter through symmetric transfer when it completes.
+ */
+template<typename T>
+class [[nodiscard]] AsyncTask
+{
+public:
+	using promise_type = detail::AsyncPromise<T>;
+	using Handle = std::coroutine_handle<promise_type>;
+
+	AsyncTask() noexcept = default;
+	explicit AsyncTask(Handle handle) noexcept : m_handle(handle) {}
+
+	AsyncTask(AsyncTask&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+
+	AsyncTask& operator=(AsyncTask&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (m_handle) m_handle.destroy();
+			m_handle = std::exchange(other.m_handle, nullptr);
+		}
+		return *this;
+	}
+
+	AsyncTask(const AsyncTask&) = delete;
+	AsyncTask& operator=(const AsyncTask&) = delete;
+
+	~AsyncTask() { if (m_handle) m_handle.destroy(); }
+
+	[[nodiscard]] bool is_done() const noexcept { return !m_handle || m_handle.done(); }
+
+	bool await_ready() const noexcept { return is_done(); }
+
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+	{
+		m_handle.promise().continuation = awaiting;
+		return m_handle;
+	}
+
+	T await_resume() { return m_handle.promise().take(); }
+
+private:
+	Handle m_handle;
+};
+
+namespace detail
+{
+	template<typename T>
+	AsyncTask<T> AsyncPromise<T>::get_return_object() noexcept
+	{
+		return AsyncTask<T>(std::coroutine_handle<AsyncPromise<T>>::from_promise(*this));
+	}
+
+	inline AsyncTask<void> AsyncPromise<void>::get_return_object() noexcept
+	{
+		return AsyncTask<void>(std::coroutine_handle<AsyncPromise<void>>::from_promise(*this));
+	}
+} // namespace detail
+
+/**
+ * @brief Awaitable that resumes the coroutine on a pool worker
+ *
+ * Once the pool is stopping the coroutine resumes immediately and the
+ * co_await throws TaskCancelled, so it unwinds instead of never resuming.
+ */
+class ScheduleAwaitable
+{
+public:
+	ScheduleAwaitable(ThreadManager& thread_manager, ThreadManager::ThreadType lane) noexcept
+		: m_thread_manager(thread_manager), m_lane(lane) {}
+
+	bool await_ready() const noexcept { return false; }
+
+	bool await_suspend(std::coroutine_handle<> handle)
+	{
+		// Once posted, the coroutine may already run (and free this
+		// awaitable) on a worker, so only touch members when refused
+		const bool posted = m_thread_manager.try_post(m_lane, [handle]() { handle.resume(); });
+		if (!posted) m_stopped = true;
+		return posted;
+	}
+
+	void await_resume() const
+	{
+		if (m_stopped) throw TaskCancelled("ThreadManager stopped");
+	}
+
+private:
+	ThreadManager& m_thread_manager;
+	ThreadManager::ThreadType m_lane;
+	bool m_stopped 		{false};
+};
+
+/**
+ * @brief Awaitable that resumes the coroutine on the pool after a deadline
+ *
+ * If the pool stops first, the coroutine is resumed by stop_all() and
+ * the co_await throws TaskCancelled.
+ */
+class SleepAwaitable
+{
+public:
+	SleepAwaitable(ThreadManager& thread_manager, TimerWheel::Clock::time_point deadline,
+				   ThreadManager::ThreadType lane) noexcept
+		: m_thread_manager(thread_manager), m_deadline(deadline), m_lane(lane) {}
+
+	bool await_ready() const noexcept { return TimerWheel::Clock::now() >= m_deadline; }
+
+	bool await_suspend(std::coroutine_handle<> handle)
+	{
+		ThreadManager& thread_manager = m_thread_manager;
+		const auto lane = m_lane;
+		SleepAwaitable* const self = this;
+
+		const auto resume_stopped = [self, handle]() {
+			self->m_stopped = true;
+			handle.resume();
+		};
+
+		const bool scheduled = thread_manager.timer_wheel().schedule(m_deadline,
+			[&thread_manager, lane, handle, resume_stopped]() {
+				if (!thread_manager.try_post(lane, [handle]() { handle.resume(); })) resume_stopped();
+			},
+			resume_stopped);
+
+		if (!scheduled) m_stopped = true;
+		return scheduled;
+	}
+
+	void await_resume() const
+	{
+		if (m_stopped) throw TaskCancelled("ThreadManager stopped");
+	}
+
+private:
+	ThreadManager& m_thread_manager;
+	TimerWheel::Clock::time_point m_deadline;
+	ThreadManager::ThreadType m_lane;
+	bool m_stopped 		{false};
+};
+
+/**
+ * @brief co_await schedule_on(tm, lane) continues on a worker of `tm`
+ */
+inline ScheduleAwaitable schedule_on(ThreadManager& thread_manager,
+									 ThreadManager::ThreadType lane = ThreadManager::DEFAULT_LANE) noexcept
+{
+	return ScheduleAwaitable(thread_manager, lane);
+}
+
+/**
+ * @brief co_await on(lane) continues on a worker of the registered ThreadManager
+ */
+inline ScheduleAwaitable on(ThreadManager::ThreadType lane)
+{
+	return ScheduleAwaitable(*ServiceLocator::resolve<ThreadManager>(), lane);
+}
+
+/**
+ * @brief co_await sleep_until(tm, deadline) without blocking any thread
+ */
+inline SleepAwaitable sleep_until(ThreadManager& thread_manager, TimerWheel::Clock::time_point deadline,
+								  ThreadManager::ThreadType lane = ThreadManager::DEFAULT_LANE) noexcept
+{
+	return SleepAwaitable(thread_manager, deadline, lane);
+}
+
+/**
+ * @brief co_await sleep_for(tm, duration) without blocking any thread
+ */
+template<typename Rep, typename Period>
+SleepAwaitable sleep_for(ThreadManager& thread_manager, std::chrono::duration<Rep, Period> duration,
+						 ThreadManager::ThreadType lane = ThreadManager::DEFAULT_LANE) noexcept
+{
+	return SleepAwaitable(thread_manager,
+						  TimerWheel::Clock::now() + std::chrono::duration_cast<TimerWheel::Clock::duration>(duration),
+						  lane);
+}
+
+/**
+ * @brief co_await sleep_for(duration) using the registered ThreadManager
+ */
+template<typename Rep, typename Period>
+SleepAwaitable sleep_for(std::chrono::duration<Rep, Period> duration)
+{
+	return sleep_for(*ServiceLocator::resolve<ThreadManager>(), duration);
+}
+
+namespace detail
+{
+	template<typename T>
+	DetachedTask run_detached(ThreadManager& thread_manager, ThreadManager::ThreadType lane,
+							  AsyncTask<T> task, TaskPromise<T> promise)
+	{
+		try
+		{
+			// Throws TaskCancelled into the promise if the pool is stopping
+			co_await schedule_on(thread_manager, lane);
+
+			if constexpr (std::is_void_v<T>)
+			{
+				co_await task;
+				promise.set_value();
+			}
+			else
+			{
+				promise.set_value(co_await task);
+			}
+		}
+		catch (...)
+		{
+			promise.set_exception(std::current_exception());
+		}
+	}
+} // namespace detail
+
+/**
+ * @brief Starts a task on the pool and detaches it
+ * @return Future completed with the task's result (or exception)
+ *
+ * Use the future to join a coroutine from non-coroutine code, e.g.
+ * spawn(tm, load_scene()).get() on the main thread.
+ */
+template<typename T>
+TaskFuture<T> spawn(ThreadManager& thread_manager, AsyncTask<T> task,
+					ThreadManager::ThreadType lane = ThreadManager::DEFAULT_LANE)
+{
+	TaskPromise<T> promise;
+	TaskFuture<T> future = promise.get_future();
+
+	// Runs up to its first co_await, which hands it to the pool
+	detail::run_detached(thread_manager, lane, std::move(task), std::move(promise)).handle.resume();
+	return future;
+}
+
+} // namespace RoboTact::Core
+
+#endif // COROUTINE_HPP
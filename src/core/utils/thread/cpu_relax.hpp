@@ -0,0 +1,32 @@
+#ifndef CPU_RELAX_HPP
+#define CPU_RELAX_HPP
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace RoboTact::Core
+{
+
+/**
+ * @brief Spin-wait hint for the CPU (PAUSE on x86, YIELD on ARM)
+ *
+ * Lowers power draw and frees pipeline resources for the SMT sibling
+ * while a thread busy-waits; no-op on unknown architectures.
+ */
+inline void cpu_relax() noexcept
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    __yield();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__aarch64__) || defined(__arm__))
+    __asm__ __volatile__("yield");
+#endif
+}
+
+} // namespace RoboTact::Core
+
+#endif // CPU_RELAX_HPP
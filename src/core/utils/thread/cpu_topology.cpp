@@ -0,0 +1,201 @@
+#include "cpu_topology.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <tuple>
+
+#if defined(ROBOTACT_PLATFORM_LINUX)
+    #include <sched.h>
+#endif
+
+namespace RoboTact::Core
+{
+	namespace
+	{
+	    /**
+	     * @brief Parses the kernel's cpulist format, e.g. "0-3,8,10-11"
+	     */
+	    std::vector<int> parse_cpu_list(const std::string& text)
+	    {
+	        std::vector<int> cpus;
+	        std::stringstream stream(text);
+	        std::string range;
+
+	        while (std::getline(stream, range, ','))
+	        {
+	            if (range.empty() || range == "\n") continue;
+	            try
+	            {
+	                const auto dash = range.find('-');
+	                const int first = std::stoi(range.substr(0, dash));
+	                const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+	                for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+	            }
+	            catch (const std::exception&)
+	            {
+	                return {};
+	            }
+	        }
+	        return cpus;
+	    }
+
+	    bool read_line(const std::filesystem::path& path, std::string& line)
+	    {
+	        std::ifstream file(path);
+	        return file && std::getline(file, line);
+	    }
+
+	    int read_int(const std::filesystem::path& path, int fallback)
+	    {
+	        std::string line;
+	        if (!read_line(path, line)) return fallback;
+	        try
+	        {
+	            return std::stoi(line);
+	        }
+	        catch (const std::exception&)
+	        {
+	            return fallback;
+	        }
+	    }
+
+	    int read_node(const std::filesystem::path& cpu_dir)
+	    {
+	        // The CPU directory holds a "nodeN" link for its NUMA node
+	        std::error_code error;
+	        for (const auto& entry : std::filesystem::directory_iterator(cpu_dir, error))
+	        {
+	            const std::string name = entry.path().filename().string();
+	            if (name.size() > 4 && name.compare(0, 4, "node") == 0 &&
+	                std::all_of(name.begin() + 4, name.end(), [](char c) { return c >= '0' && c <= '9'; }))
+	            {
+	                return std::stoi(name.substr(4));
+	            }
+	        }
+	        return 0;
+	    }
+	}
+
+	CpuTopology CpuTopology::detect()
+	{
+	#if defined(ROBOTACT_PLATFORM_LINUX)
+	    CpuTopology topology = from_sysfs("/sys/devices/system/cpu");
+	    topology.restrict_to_affinity();
+	    if (!topology.empty()) return topology;
+	#endif
+	    return flat(std::max(1u, std::thread::hardware_concurrency()));
+	}
+
+	CpuTopology CpuTopology::from_sysfs(const std::filesystem::path& root)
+	{
+	    CpuTopology topology;
+
+	    std::string online;
+	    if (!read_line(root / "online", online) && !read_line(root / "present", online))
+	    {
+	        return topology;
+	    }
+
+	    for (int id : parse_cpu_list(online))
+	    {
+	        const auto cpu_dir = root / ("cpu" + std::to_string(id));
+	        const auto topology_dir = cpu_dir / "topology";
+
+	        CpuInfo info;
+	        info.id = id;
+	        info.package = read_int(topology_dir / "physical_package_id", 0);
+	        info.node = read_node(cpu_dir);
+
+	        std::string siblings_text;
+	        const std::vector<int> siblings = read_line(topology_dir / "thread_siblings_list", siblings_text)
+	            ? parse_cpu_list(siblings_text)
+	            : std::vector<int>{};
+	        info.core = siblings.empty() ? id : *std::min_element(siblings.begin(), siblings.end());
+
+	        topology.m_cpus.push_back(info);
+	    }
+
+	    topology.m_detected = !topology.m_cpus.empty();
+	    return topology;
+	}
+
+	CpuTopology CpuTopology::flat(std::size_t count)
+	{
+	    CpuTopology topology;
+	    for (std::size_t i = 0; i < count; ++i)
+	    {
+	        const int id = static_cast<int>(i);
+	        topology.m_cpus.push_back(CpuInfo{ id, id, 0, 0 });
+	    }
+	    return topology;
+	}
+
+	std::size_t CpuTopology::physical_core_count() const
+	{
+	    std::set<int> cores;
+	    for (const auto& cpu : m_cpus) cores.insert(cpu.core);
+	    return cores.size();
+	}
+
+	std::size_t CpuTopology::node_count() const
+	{
+	    std::set<int> nodes;
+	    for (const auto& cpu : m_cpus) nodes.insert(cpu.node);
+	    return std::max<std::size_t>(1, nodes.size());
+	}
+
+	std::vector<CpuInfo> CpuTopology::placement_order(bool include_smt_siblings) const
+	{
+	    std::vector<CpuInfo> primaries;
+	    std::vector<CpuInfo> siblings;
+
+	    for (const auto& cpu : m_cpus)
+	    {
+	        // With a restricted affinity mask the core's lowest CPU may be
+	        // missing, so the first allowed CPU of each core is its primary
+	        const bool seen = std::any_of(primaries.begin(), primaries.end(),
+	                                      [&cpu](const CpuInfo& p) { return p.core == cpu.core; });
+	        (seen ? siblings : primaries).push_back(cpu);
+	    }
+
+	    const auto by_location = [](const CpuInfo& a, const CpuInfo& b) {
+	        return std::tie(a.node, a.package, a.core, a.id) < std::tie(b.node, b.package, b.core, b.id);
+	    };
+	    std::sort(primaries.begin(), primaries.end(), by_location);
+	    std::sort(siblings.begin(), siblings.end(), by_location);
+
+	    if (include_smt_siblings)
+	    {
+	        primaries.insert(primaries.end(), siblings.begin(), siblings.end());
+	    }
+	    return primaries;
+	}
+
+	int CpuTopology::node_of(int cpu) const noexcept
+	{
+	    for (const auto& info : m_cpus)
+	    {
+	        if (info.id == cpu) return info.node;
+	    }
+	    return 0;
+	}
+
+	void CpuTopology::restrict_to_affinity()
+	{
+	#if defined(ROBOTACT_PLATFORM_LINUX)
+	    cpu_set_t allowed;
+	    CPU_ZERO(&allowed);
+	    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return;
+
+	    m_cpus.erase(std::remove_if(m_cpus.begin(), m_cpus.end(), [&allowed](const CpuInfo& cpu) {
+	        return cpu.id < 0 || cpu.id >= CPU_SETSIZE || !CPU_ISSET(cpu.id, &allowed);
+	    }), m_cpus.end());
+	#endif
+	}
+
+} // namespace RoboTact::Core
@@ -0,0 +1,89 @@
+#ifndef CPU_TOPOLOGY_HPP
+#define CPU_TOPOLOGY_HPP
+
+/**
+ * @brief Logical CPU / physical core / NUMA node layout of the machine
+ *
+ * Read from /sys/devices/system/cpu on Linux and restricted to the CPUs
+ * the process may run on. Elsewhere (or if sysfs is unreadable) every
+ * logical CPU is treated as its own core on a single node.
+ */
+
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+namespace RoboTact::Core
+{
+
+/**
+ * @struct CpuInfo
+ * @brief One logical CPU
+ */
+struct CpuInfo
+{
+    int id              {0};    ///< Logical CPU number (as used for affinity)
+    int core            {0};    ///< Lowest logical CPU sharing this physical core
+    int package         {0};    ///< Physical socket
+    int node            {0};    ///< NUMA node
+};
+
+/**
+ * @class CpuTopology
+ * @brief Snapshot of the CPU layout used to size and place thread pools
+ */
+class CpuTopology
+{
+public:
+    /**
+     * @brief Reads the topology of the running machine
+     */
+    static CpuTopology detect();
+
+    /**
+     * @brief Parses a sysfs CPU directory (e.g. /sys/devices/system/cpu)
+     * @return Empty topology if the directory cannot be read
+     */
+    static CpuTopology from_sysfs(const std::filesystem::path& root);
+
+    /**
+     * @brief `count` single-threaded cores on one node
+     */
+    static CpuTopology flat(std::size_t count);
+
+    [[nodiscard]] const std::vector<CpuInfo>& cpus() const noexcept { return m_cpus; }
+    [[nodiscard]] bool empty() const noexcept { return m_cpus.empty(); }
+
+    /**
+     * @brief false if this is a flat fallback rather than the real layout
+     */
+    [[nodiscard]] bool is_detected() const noexcept { return m_detected; }
+
+    [[nodiscard]] std::size_t logical_cpu_count() const noexcept { return m_cpus.size(); }
+    [[nodiscard]] std::size_t physical_core_count() const;
+    [[nodiscard]] std::size_t node_count() const;
+
+    /**
+     * @brief CPUs in placement order: one per physical core, grouped by
+     *        node, then (optionally) the remaining SMT siblings
+     */
+    [[nodiscard]] std::vector<CpuInfo> placement_order(bool include_smt_siblings) const;
+
+    /**
+     * @brief Node of a logical CPU (0 if unknown)
+     */
+    [[nodiscard]] int node_of(int cpu) const noexcept;
+
+    /**
+     * @brief Drops CPUs the process is not allowed to run on
+     */
+    void restrict_to_affinity();
+
+private:
+    std::vector<CpuInfo> m_cpus;
+    bool m_detected     {false};
+};
+
+} // namespace RoboTact::Core
+
+#endif // CPU_TOPOLOGY_HPP
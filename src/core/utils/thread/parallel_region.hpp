@@ -0,0 +1,106 @@
+#ifndef PARALLEL_REGION_HPP
+#define PARALLEL_REGION_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+
+namespace RoboTact::Core::detail
+{
+
+/**
+ * @class ParallelRegion
+ * @brief Shared bookkeeping of one parallel_for/parallel_reduce call
+ *
+ * Chunks are claimed with a single fetch_add, so the caller and any
+ * number of helper tasks can pull work without coordination. Helpers
+ * only dereference the chunk body after successfully claiming a chunk,
+ * and the caller does not return before every claimed chunk is done,
+ * so the body may safely live on the caller's stack.
+ */
+class ParallelRegion
+{
+public:
+	explicit ParallelRegion(std::size_t chunk_count) noexcept
+		: m_chunk_count(chunk_count) {}
+
+	ParallelRegion(const ParallelRegion&) = delete;
+	ParallelRegion& operator=(const ParallelRegion&) = delete;
+
+	/**
+	 * @brief Claims and runs chunks until none are left
+	 * @param chunk Callable invoked as chunk(chunk_index)
+	 */
+	template<typename ChunkFn>
+	void run(ChunkFn& chunk) noexcept
+	{
+		for (;;)
+		{
+			const std::size_t index = m_next_chunk.fetch_add(1, std::memory_order_relaxed);
+			if (index >= m_chunk_count) return;
+
+			if (!m_failed.load(std::memory_order_relaxed))
+			{
+				try {
+					chunk(index);
+				} catch (...) {
+					capture_exception();
+				}
+			}
+
+			if (m_done_chunks.fetch_add(1, std::memory_order_acq_rel) + 1 == m_chunk_count)
+			{
+				m_done_chunks.notify_all();
+			}
+		}
+	}
+
+	[[nodiscard]] std::size_t done_chunks() const noexcept
+	{
+		return m_done_chunks.load(std::memory_order_acquire);
+	}
+
+	[[nodiscard]] std::size_t chunk_count() const noexcept { return m_chunk_count; }
+
+	/**
+	 * @brief Blocks until the done counter moves past `seen`
+	 */
+	void wait_for_progress(std::size_t seen) const noexcept
+	{
+		m_done_chunks.wait(seen, std::memory_order_acquire);
+	}
+
+	/**
+	 * @brief Rethrows the first exception thrown by any chunk
+	 */
+	void rethrow_if_failed() const
+	{
+		if (m_failed.load(std::memory_order_acquire))
+		{
+			std::rethrow_exception(m_exception);
+		}
+	}
+
+private:
+	void capture_exception() noexcept
+	{
+		std::lock_guard<std::mutex> lock(m_exception_mutex);
+		if (!m_exception)
+		{
+			m_exception = std::current_exception();
+			m_failed.store(true, std::memory_order_release);
+		}
+	}
+
+	const std::size_t m_chunk_count;
+	alignas(64) std::atomic<std::size_t> m_next_chunk 	{0};
+	alignas(64) std::atomic<std::size_t> m_done_chunks 	{0};
+	std::atomic<bool> m_failed 							{false};
+	std::mutex m_exception_mutex;
+	std::exception_ptr m_exception;
+};
+
+} // namespace RoboTact::Core::detail
+
+#endif // PARALLEL_REGION_HPP
@@ -0,0 +1,151 @@
+#ifndef TASK_FUNCTION_HPP
+#define TASK_FUNCTION_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @def ROBOTACT_TASK_INLINE_SIZE
+ * @brief Bytes of inline capture storage in a TaskFunction
+ *
+ * Callables up to this size are stored without touching the heap.
+ * Override from the build (see CMake option of the same name).
+ */
+#ifndef ROBOTACT_TASK_INLINE_SIZE
+    #define ROBOTACT_TASK_INLINE_SIZE 64
+#endif
+
+namespace RoboTact::Core
+{
+
+/**
+ * @class TaskFunction
+ * @brief Move-only, type-erased `void()` callable with small-buffer storage
+ *
+ * Replacement for std::function on the task dispatch path:
+ * - No copy requirement, so move-only captures (promises, unique_ptr) work
+ * - Captures up to ROBOTACT_TASK_INLINE_SIZE bytes are stored inline
+ * - Larger (or throwing-move) callables fall back to one heap allocation
+ */
+class TaskFunction
+{
+public:
+	static constexpr std::size_t INLINE_SIZE = ROBOTACT_TASK_INLINE_SIZE;
+	static_assert(INLINE_SIZE >= sizeof(void*), "Inline storage must hold a pointer");
+
+	/**
+	 * @brief Whether a callable of type F is stored without allocating
+	 */
+	template<typename F>
+	static constexpr bool stores_inline =
+		sizeof(F) <= INLINE_SIZE &&
+		alignof(F) <= alignof(std::max_align_t) &&
+		std::is_nothrow_move_constructible_v<F>;
+
+	TaskFunction() noexcept = default;
+
+	template<typename F,
+			 typename Fn = std::decay_t<F>,
+			 typename = std::enable_if_t<!std::is_same_v<Fn, TaskFunction> &&
+										 std::is_invocable_v<Fn&>>>
+	TaskFunction(F&& f)
+	{
+		if constexpr (stores_inline<Fn>)
+		{
+			::new (static_cast<void*>(m_storage)) Fn(std::forward<F>(f));
+			m_vtable = &INLINE_VTABLE<Fn>;
+		}
+		else
+		{
+			::new (static_cast<void*>(m_storage)) Fn*(new Fn(std::forward<F>(f)));
+			m_vtable = &HEAP_VTABLE<Fn>;
+		}
+	}
+
+	TaskFunction(TaskFunction&& other) noexcept
+		: m_vtable(other.m_vtable)
+	{
+		if (m_vtable)
+		{
+			m_vtable->move(m_storage, other.m_storage);
+			other.m_vtable = nullptr;
+		}
+	}
+
+	TaskFunction& operator=(TaskFunction&& other) noexcept
+	{
+		if (this != &other)
+		{
+			reset();
+			if (other.m_vtable)
+			{
+				m_vtable = other.m_vtable;
+				m_vtable->move(m_storage, other.m_storage);
+				other.m_vtable = nullptr;
+			}
+		}
+		return *this;
+	}
+
+	TaskFunction(const TaskFunction&) = delete;
+	TaskFunction& operator=(const TaskFunction&) = delete;
+
+	~TaskFunction() { reset(); }
+
+	/**
+	 * @brief Invokes the stored callable
+	 * @pre The TaskFunction is non-empty
+	 */
+	void operator()() { m_vtable->invoke(m_storage); }
+
+	explicit operator bool() const noexcept { return m_vtable != nullptr; }
+
+	/**
+	 * @brief Destroys the stored callable, leaving the TaskFunction empty
+	 */
+	void reset() noexcept
+	{
+		if (m_vtable)
+		{
+			m_vtable->destroy(m_storage);
+			m_vtable = nullptr;
+		}
+	}
+
+private:
+	struct VTable
+	{
+		void (*invoke)(void* storage);
+		void (*move)(void* dst, void* src) noexcept;
+		void (*destroy)(void* storage) noexcept;
+	};
+
+	template<typename Fn>
+	static constexpr VTable INLINE_VTABLE {
+		[](void* s) { (*std::launder(static_cast<Fn*>(s)))(); },
+		[](void* dst, void* src) noexcept {
+			Fn* from = std::launder(static_cast<Fn*>(src));
+			::new (dst) Fn(std::move(*from));
+			from->~Fn();
+		},
+		[](void* s) noexcept { std::launder(static_cast<Fn*>(s))->~Fn(); }
+	};
+
+	template<typename Fn>
+	static constexpr VTable HEAP_VTABLE {
+		[](void* s) { (**std::launder(static_cast<Fn**>(s)))(); },
+		[](void* dst, void* src) noexcept {
+			::new (dst) Fn*(*std::launder(static_cast<Fn**>(src)));
+		},
+		[](void* s) noexcept { delete *std::launder(static_cast<Fn**>(s)); }
+	};
+
+	alignas(std::max_align_t) std::byte m_storage[INLINE_SIZE];
+	const VTable* m_vtable 						{nullptr};
+};
+
+} // namespace RoboTact::Core
+
+#endif // TASK_FUNCTION_HPP
@@ -0,0 +1,300 @@
+#ifndef TASK_FUTURE_HPP
+#define TASK_FUTURE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace RoboTact::Core
+{
+
+/**
+ * @class TaskState
+ * @brief Intrusively ref-counted shared state behind TaskPromise/TaskFuture
+ *
+ * Compared to the std::promise/std::future state this has no mutex or
+ * condition variable: readiness is a single atomic flag that consumers
+ * wait on with C++20 atomic wait. Submitted tasks derive from it so the
+ * callable and its result live in the same allocation.
+ *
+ * @tparam R Result type (void allowed, references are not)
+ */
+template<typename R>
+class TaskState
+{
+	static_assert(!std::is_reference_v<R>, "TaskState does not store references");
+
+public:
+	virtual ~TaskState() = default;
+
+	TaskState(const TaskState&) = delete;
+	TaskState& operator=(const TaskState&) = delete;
+
+	void add_ref() noexcept { m_refs.fetch_add(1, std::memory_order_relaxed); }
+
+	void release() noexcept
+	{
+		if (m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			delete this;
+		}
+	}
+
+	template<typename... V>
+	void set_value(V&&... value)
+	{
+		m_value.emplace(std::forward<V>(value)...);
+		publish();
+	}
+
+	void set_exception(std::exception_ptr exception) noexcept
+	{
+		m_exception = std::move(exception);
+		publish();
+	}
+
+	[[nodiscard]] bool is_ready() const noexcept
+	{
+		return m_ready.load(std::memory_order_acquire);
+	}
+
+	void wait() const noexcept
+	{
+		while (!m_ready.load(std::memory_order_acquire))
+		{
+			m_ready.wait(false, std::memory_order_acquire);
+		}
+	}
+
+	/**
+	 * @brief Waits for the result and moves it out (single consumer)
+	 * @throws Whatever exception the producer stored
+	 */
+	R take()
+	{
+		wait();
+		if (m_exception) std::rethrow_exception(m_exception);
+		if constexpr (!std::is_void_v<R>)
+		{
+			return std::move(*m_value);
+		}
+	}
+
+protected:
+	TaskState() = default;
+
+private:
+	using Storage = std::conditional_t<std::is_void_v<R>, char, R>;
+
+	void publish() noexcept
+	{
+		m_ready.store(true, std::memory_order_release);
+		m_ready.notify_all();
+	}
+
+	std::atomic<std::uint32_t> m_refs 	{1};
+	std::atomic<bool> m_ready 			{false};
+	std::optional<Storage> m_value;
+	std::exception_ptr m_exception;
+};
+
+/**
+ * @class TaskFuture
+ * @brief Move-only consumer handle of a TaskState
+ *
+ * Lighter counterpart to std::future, returned by ThreadManager::submit().
+ */
+template<typename R>
+class TaskFuture
+{
+public:
+	TaskFuture() noexcept = default;
+	explicit TaskFuture(TaskState<R>* state) noexcept : m_state(state) {}
+
+	TaskFuture(TaskFuture&& other) noexcept
+		: m_state(std::exchange(other.m_state, nullptr)) {}
+
+	TaskFuture& operator=(TaskFuture&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (m_state) m_state->release();
+			m_state = std::exchange(other.m_state, nullptr);
+		}
+		return *this;
+	}
+
+	TaskFuture(const TaskFuture&) = delete;
+	TaskFuture& operator=(const TaskFuture&) = delete;
+
+	~TaskFuture() { if (m_state) m_state->release(); }
+
+	[[nodiscard]] bool valid() const noexcept { return m_state != nullptr; }
+	[[nodiscard]] bool is_ready() const noexcept { return m_state->is_ready(); }
+	void wait() const noexcept { m_state->wait(); }
+
+	/**
+	 * @brief Blocks until the result is available and returns it
+	 * @note Invalidates the future, like std::future::get()
+	 */
+	R get()
+	{
+		TaskState<R>* state = std::exchange(m_state, nullptr);
+		struct Release { TaskState<R>* s; ~Release() { s->release(); } } guard{state};
+		return state->take();
+	}
+
+private:
+	TaskState<R>* m_state 				{nullptr};
+};
+
+/**
+ * @class TaskPromise
+ * @brief Move-only producer handle of a TaskState
+ *
+ * A promise destroyed without a result breaks its future with
+ * std::future_errc::broken_promise instead of leaving it hanging.
+ */
+template<typename R>
+class TaskPromise
+{
+public:
+	/**
+	 * @brief Creates a promise with its own (standalone) shared state
+	 */
+	TaskPromise() : m_state(new PlainState()) {}
+
+	/**
+	 * @brief Adopts an existing state reference (used by submitted tasks)
+	 */
+	explicit TaskPromise(TaskState<R>* state) noexcept : m_state(state) {}
+
+	TaskPromise(TaskPromise&& other) noexcept
+		: m_state(std::exchange(other.m_state, nullptr)) {}
+
+	TaskPromise& operator=(TaskPromise&& other) noexcept
+	{
+		if (this != &other)
+		{
+			abandon();
+			m_state = std::exchange(other.m_state, nullptr);
+		}
+		return *this;
+	}
+
+	TaskPromise(const TaskPromise&) = delete;
+	TaskPromise& operator=(const TaskPromise&) = delete;
+
+	~TaskPromise() { abandon(); }
+
+	/**
+	 * @brief Returns a future sharing this promise's state
+	 */
+	[[nodiscard]] TaskFuture<R> get_future()
+	{
+		m_state->add_ref();
+		return TaskFuture<R>(m_state);
+	}
+
+	template<typename... V>
+	void set_value(V&&... value) { m_state->set_value(std::forward<V>(value)...); }
+
+	void set_exception(std::exception_ptr exception) noexcept
+	{
+		m_state->set_exception(std::move(exception));
+	}
+
+	[[nodiscard]] TaskState<R>* state() const noexcept { return m_state; }
+
+private:
+	struct PlainState final : TaskState<R> {};
+
+	void abandon() noexcept
+	{
+		if (!m_state) return;
+		if (!m_state->is_ready())
+		{
+			m_state->set_exception(std::make_exception_ptr(
+				std::future_error(std::future_errc::broken_promise)));
+		}
+		m_state->release();
+		m_state = nullptr;
+	}
+
+	TaskState<R>* m_state;
+};
+
+namespace detail
+{
+	/**
+	 * @brief Shared state that also stores the callable producing it
+	 *
+	 * One allocation holds the bound callable, the result and the
+	 * ref-count; the queued task only carries a pointer to it.
+	 */
+	template<typename R, typename Fn>
+	class PackagedTaskState final : public TaskState<R>
+	{
+	public:
+		explicit PackagedTaskState(Fn&& fn) : m_fn(std::move(fn)) {}
+
+		void run(TaskPromise<R>& promise)
+		{
+			try
+			{
+				if constexpr (std::is_void_v<R>)
+				{
+					std::invoke(m_fn);
+					promise.set_value();
+				}
+				else
+				{
+					promise.set_value(std::invoke(m_fn));
+				}
+			}
+			catch (...)
+			{
+				promise.set_exception(std::current_exception());
+			}
+		}
+
+	private:
+		Fn m_fn;
+	};
+
+	/**
+	 * @brief Queue-side half of a submitted task (fits in TaskFunction inline)
+	 */
+	template<typename R, typename Fn>
+	class PackagedTaskRunner
+	{
+	public:
+		explicit PackagedTaskRunner(PackagedTaskState<R, Fn>* state) noexcept
+			: m_promise(state) {}
+
+		void operator()()
+		{
+			static_cast<PackagedTaskState<R, Fn>*>(m_promise.state())->run(m_promise);
+		}
+
+		/**
+		 * @brief Completes the future with `exception` without running the task
+		 */
+		void cancel(std::exception_ptr exception) noexcept
+		{
+			m_promise.set_exception(std::move(exception));
+		}
+
+	private:
+		TaskPromise<R> m_promise;
+	};
+} // namespace detail
+
+} // namespace RoboTact::Core
+
+#endif // TASK_FUTURE_HPP
@@ -0,0 +1,283 @@
+#include "task_graph.hpp"
+#include "thread_manager.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace RoboTact::Core
+{
+	/**
+	 * @brief Pool task running one node
+	 *
+	 * A queued node the pool drops without running it (emergency stop,
+	 * shutdown) is cancelled from the destructor, so the run still ends.
+	 */
+	struct TaskGraph::ScheduledNode
+	{
+	    TaskGraph* graph;
+	    ThreadManager* thread_manager;
+	    NodeId id;
+
+	    ScheduledNode(TaskGraph* g, ThreadManager* manager, NodeId node) noexcept
+	        : graph(g), thread_manager(manager), id(node) {}
+
+	    ScheduledNode(ScheduledNode&& other) noexcept
+	        : graph(std::exchange(other.graph, nullptr)), thread_manager(other.thread_manager), id(other.id) {}
+
+	    ScheduledNode& operator=(ScheduledNode&&) = delete;
+
+	    ~ScheduledNode()
+	    {
+	        if (graph) graph->cancel(*thread_manager, id);
+	    }
+
+	    void operator()()
+	    {
+	        TaskGraph* const owner = std::exchange(graph, nullptr);
+	        owner->m_queued_nodes.fetch_sub(1);
+	        owner->execute(*thread_manager, id);
+	    }
+	};
+
+	TaskGraph::NodeHandle& TaskGraph::NodeHandle::precede(NodeHandle other)
+	{
+	    m_graph->precede(*this, other);
+	    return *this;
+	}
+
+	TaskGraph::NodeHandle& TaskGraph::NodeHandle::succeed(NodeHandle other)
+	{
+	    m_graph->precede(other, *this);
+	    return *this;
+	}
+
+	TaskGraph::NodeHandle TaskGraph::NodeHandle::then(std::function<void()> work)
+	{
+	    NodeHandle next = m_graph->add(std::move(work));
+	    m_graph->precede(*this, next);
+	    return next;
+	}
+
+	TaskGraph::NodeHandle TaskGraph::add(std::function<void()> work)
+	{
+	    if (is_running())
+	    {
+	        throw std::logic_error("TaskGraph modified while running");
+	    }
+
+	    m_nodes.emplace_back().work = std::move(work);
+	    m_dirty = true;
+	    return NodeHandle(this, static_cast<NodeId>(m_nodes.size() - 1));
+	}
+
+	void TaskGraph::precede(NodeHandle before, NodeHandle after)
+	{
+	    if (is_running())
+	    {
+	        throw std::logic_error("TaskGraph modified while running");
+	    }
+
+	    if (before.m_graph != this || after.m_graph != this ||
+	        before.m_id >= m_nodes.size() || after.m_id >= m_nodes.size())
+	    {
+	        throw std::invalid_argument("TaskGraph::precede: node does not belong to this graph");
+	    }
+
+	    m_nodes[before.m_id].successors.push_back(after.m_id);
+	    ++m_nodes[after.m_id].dependency_count;
+	    m_dirty = true;
+	}
+
+	bool TaskGraph::is_running() const noexcept
+	{
+	    std::lock_guard<std::mutex> lock(m_mutex);
+	    return m_running;
+	}
+
+	void TaskGraph::validate()
+	{
+	    // Kahn's algorithm: every node must be reachable in topological order
+	    std::vector<std::uint32_t> in_degree(m_nodes.size());
+	    std::vector<NodeId> ready;
+
+	    m_roots.clear();
+	    for (NodeId id = 0; id < m_nodes.size(); ++id)
+	    {
+	        in_degree[id] = m_nodes[id].dependency_count;
+	        if (in_degree[id] == 0)
+	        {
+	            m_roots.push_back(id);
+	            ready.push_back(id);
+	        }
+	    }
+
+	    std::size_t visited = 0;
+	    while (!ready.empty())
+	    {
+	        const NodeId id = ready.back();
+	        ready.pop_back();
+	        ++visited;
+
+	        for (NodeId successor : m_nodes[id].successors)
+	        {
+	            if (--in_degree[successor] == 0) ready.push_back(successor);
+	        }
+	    }
+
+	    if (visited != m_nodes.size())
+	    {
+	        throw std::logic_error("TaskGraph contains a dependency cycle");
+	    }
+	    m_dirty = false;
+	}
+
+	void TaskGraph::run(ThreadManager& thread_manager)
+	{
+	    {
+	        std::lock_guard<std::mutex> lock(m_mutex);
+	        if (m_running)
+	        {
+	            throw std::logic_error("TaskGraph is already running");
+	        }
+	        if (m_dirty) validate();
+	        if (m_nodes.empty()) return;
+	        m_running = true;
+	    }
+
+	    for (auto& node : m_nodes)
+	    {
+	        node.remaining.store(node.dependency_count, std::memory_order_relaxed);
+	    }
+	    m_exception = nullptr;
+	    m_failed.store(false, std::memory_order_relaxed);
+	    m_pending_nodes.store(m_nodes.size(), std::memory_order_release);
+
+	    for (NodeId root : m_roots)
+	    {
+	        schedule(thread_manager, root);
+	    }
+	}
+
+	void TaskGraph::wait(ThreadManager& thread_manager)
+	{
+	    std::unique_lock<std::mutex> lock(m_mutex);
+	    while (m_running)
+	    {
+	        lock.unlock();
+	        const bool helped = thread_manager.try_run_pending_task();
+	        lock.lock();
+	        if (helped) continue;
+
+	        // Nothing to help with: the remaining nodes are in flight elsewhere.
+	        // schedule() wakes us when one is queued (it may land in our own
+	        // deque), finish_run() when the run is over.
+	        m_waiters.fetch_add(1);
+	        m_finished_cv.wait(lock, [this]{ return !m_running || m_queued_nodes.load() > 0; });
+	        m_waiters.fetch_sub(1);
+	    }
+
+	    if (m_exception)
+	    {
+	        std::rethrow_exception(std::exchange(m_exception, nullptr));
+	    }
+	}
+
+	void TaskGraph::run_and_wait(ThreadManager& thread_manager)
+	{
+	    run(thread_manager);
+	    wait(thread_manager);
+	}
+
+	void TaskGraph::schedule(ThreadManager& thread_manager, NodeId id) noexcept
+	{
+	    // Counted before publishing, see wait()
+	    m_queued_nodes.fetch_add(1);
+
+	    // A node that is refused (pool stopping) or fails to enqueue is
+	    // cancelled by the ScheduledNode destructor
+	    bool posted = false;
+	    try {
+	        posted = thread_manager.try_post(ThreadManager::DEFAULT_LANE, ScheduledNode(this, &thread_manager, id));
+	    } catch (...) {}
+
+	    if (posted && m_waiters.load() > 0)
+	    {
+	        std::lock_guard<std::mutex> lock(m_mutex);
+	        m_finished_cv.notify_all();
+	    }
+	}
+
+	void TaskGraph::execute(ThreadManager& thread_manager, NodeId id) noexcept
+	{
+	    while (id != NO_NODE)
+	    {
+	        Node& node = m_nodes[id];
+
+	        if (!m_failed.load(std::memory_order_relaxed))
+	        {
+	            // Nodes that have not started once the pool stops are cancelled
+	            if (!thread_manager.should_continue())
+	            {
+	                fail(cancelled_error());
+	            }
+	            else
+	            {
+	                try {
+	                    node.work();
+	                } catch (...) {
+	                    fail(std::current_exception());
+	                }
+	            }
+	        }
+
+	        // Keep one ready successor for this thread, hand the rest to the pool
+	        NodeId next = NO_NODE;
+	        for (NodeId successor : node.successors)
+	        {
+	            if (m_nodes[successor].remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	            {
+	                if (next != NO_NODE) schedule(thread_manager, next);
+	                next = successor;
+	            }
+	        }
+
+	        if (m_pending_nodes.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	        {
+	            finish_run();
+	            return;
+	        }
+	        id = next;
+	    }
+	}
+
+	void TaskGraph::cancel(ThreadManager& thread_manager, NodeId id) noexcept
+	{
+	    // The node and everything after it settle without running their work
+	    m_queued_nodes.fetch_sub(1);
+	    fail(cancelled_error());
+	    execute(thread_manager, id);
+	}
+
+	std::exception_ptr TaskGraph::cancelled_error() noexcept
+	{
+	    return std::make_exception_ptr(TaskCancelled("ThreadManager stopped before the graph finished"));
+	}
+
+	void TaskGraph::fail(std::exception_ptr error) noexcept
+	{
+	    // First failure wins, later nodes are skipped
+	    if (!m_failed.exchange(true, std::memory_order_acq_rel))
+	    {
+	        m_exception = std::move(error);
+	    }
+	}
+
+	void TaskGraph::finish_run() noexcept
+	{
+	    // Notify under the lock: once released, the waiter may destroy the graph
+	    std::lock_guard<std::mutex> lock(m_mutex);
+	    m_running = false;
+	    m_finished_cv.notify_all();
+	}
+
+} // namespace RoboTact::Core
@@ -0,0 +1,161 @@
+#ifndef TASK_GRAPH_HPP
+#define TASK_GRAPH_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace RoboTact::Core
+{
+
+class ThreadManager;
+
+/**
+ * @class TaskGraph
+ * @brief Reusable DAG of tasks executed on the ThreadManager worker pool
+ *
+ * Nodes become runnable once all their predecessors finished; nothing
+ * blocks a worker while waiting for a dependency. A graph is built once
+ * and can be run every frame: per-run state is reset in place and the
+ * scheduled tasks fit TaskFunction's inline storage, so a run performs
+ * no heap allocation.
+ *
+ * Usage:
+ * @code
+ * TaskGraph frame;
+ * auto sensors   = frame.add([&]{ update_sensors(); });
+ * auto estimator = sensors.then([&]{ run_estimator(); });
+ * auto control   = estimator.then([&]{ run_controller(); });
+ * control.then([&]{ publish_render_state(); });
+ *
+ * frame.run_and_wait(*thread_manager);  // each frame
+ * @endcode
+ *
+ * @note Building (add/precede/then) is not thread-safe and must not
+ *       overlap with a run.
+ */
+class TaskGraph
+{
+public:
+	using NodeId = std::uint32_t;
+
+	/**
+	 * @class NodeHandle
+	 * @brief Lightweight reference to a node used to wire edges
+	 */
+	class NodeHandle
+	{
+	public:
+		/**
+		 * @brief Makes `other` wait for this node
+		 * @return *this for chaining
+		 */
+		NodeHandle& precede(NodeHandle other);
+
+		/**
+		 * @brief Makes this node wait for `other`
+		 * @return *this for chaining
+		 */
+		NodeHandle& succeed(NodeHandle other);
+
+		/**
+		 * @brief Adds a continuation that runs after this node
+		 * @return Handle of the new node
+		 */
+		NodeHandle then(std::function<void()> work);
+
+		[[nodiscard]] NodeId id() const noexcept { return m_id; }
+
+	private:
+		friend class TaskGraph;
+		NodeHandle(TaskGraph* graph, NodeId id) noexcept : m_graph(graph), m_id(id) {}
+
+		TaskGraph* m_graph;
+		NodeId m_id;
+	};
+
+	TaskGraph() = default;
+
+	TaskGraph(const TaskGraph&) = delete;
+	TaskGraph& operator=(const TaskGraph&) = delete;
+
+	/**
+	 * @brief Adds a node without dependencies
+	 * @param work Callable executed when the node runs
+	 * @return Handle used to add edges
+	 */
+	NodeHandle add(std::function<void()> work);
+
+	/**
+	 * @brief Adds the edge before -> after
+	 * @throws std::invalid_argument if a handle does not refer to a node of this graph
+	 */
+	void precede(NodeHandle before, NodeHandle after);
+
+	/**
+	 * @brief Starts a run on the pool and returns immediately
+	 * @throws std::logic_error if the graph is already running or has a cycle
+	 */
+	void run(ThreadManager& thread_manager);
+
+	/**
+	 * @brief Waits for the current run, executing pool tasks meanwhile
+	 * @throws The first exception thrown by a node during the run
+	 * @throws TaskCancelled if the pool stopped before every node ran
+	 */
+	void wait(ThreadManager& thread_manager);
+
+	/**
+	 * @brief run() followed by wait()
+	 */
+	void run_and_wait(ThreadManager& thread_manager);
+
+	[[nodiscard]] bool is_running() const noexcept;
+	[[nodiscard]] std::size_t size() const noexcept { return m_nodes.size(); }
+
+private:
+	static constexpr NodeId NO_NODE = ~NodeId{0};
+
+	struct Node
+	{
+		std::function<void()> work;
+		std::vector<NodeId> successors;
+		std::uint32_t dependency_count 				{0};
+		std::atomic<std::uint32_t> remaining 		{0};
+	};
+
+	struct ScheduledNode;
+
+	void validate();
+	void schedule(ThreadManager& thread_manager, NodeId id) noexcept;
+	void execute(ThreadManager& thread_manager, NodeId id) noexcept;
+	void cancel(ThreadManager& thread_manager, NodeId id) noexcept;
+	void fail(std::exception_ptr error) noexcept;
+	static std::exception_ptr cancelled_error() noexcept;
+	void finish_run() noexcept;
+
+	std::deque<Node> m_nodes;
+	std::vector<NodeId> m_roots;
+	bool m_dirty 									{true};
+
+	std::atomic<std::size_t> m_pending_nodes 		{0};
+	std::atomic<bool> m_failed 						{false};
+	std::exception_ptr m_exception;
+
+	// Lets a blocked wait() sleep until it has something to help with
+	std::atomic<std::size_t> m_queued_nodes 		{0};
+	std::atomic<std::uint32_t> m_waiters 			{0};
+
+	mutable std::mutex m_mutex;
+	std::condition_variable m_finished_cv;
+	bool m_running 									{false};
+};
+
+} // namespace RoboTact::Core
+
+#endif // TASK_GRAPH_HPP
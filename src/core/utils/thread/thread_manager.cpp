@@ -1,21 +1,194 @@
 #include "thread_manager.hpp"
+#include "cpu_relax.hpp"
+#include "core/utils/memory/scratch_arena.hpp"
+#include "core/utils/profiler/profiler.hpp"
+
+#include <bit>
+#include <iomanip>
+#include <limits>
+#include <sstream>
 
 namespace RoboTact::Core
 {
+	namespace
+	{
+		// Identifies the pool (and deque) the calling thread works for, so
+		// tasks spawned from inside a task land on the local deque.
+		thread_local const ThreadManager* t_worker_owner = nullptr;
+		thread_local std::size_t t_worker_index = 0;
+
+		// Successful dispatches of this thread, drives starvation protection
+		thread_local std::uint32_t t_dispatch_count = 0;
+
+		// Context of the idle-lane task running on this thread, for should_yield()
+		thread_local const ThreadManager* t_idle_owner = nullptr;
+		thread_local bool t_idle_yield_on_pending = false;
+		thread_local std::int64_t t_idle_deadline_ns = std::numeric_limits<std::int64_t>::max();
+
+		// Set by note_cancelled() while the task run_task() started bails out
+		thread_local bool t_task_cancelled = false;
+
+		// Adaptive spin budget bounds of a worker (pause iterations)
+		constexpr std::uint32_t INITIAL_SPIN = 256;
+		constexpr std::uint32_t MIN_SPIN = 16;
+
+		constexpr std::size_t lane_index(ThreadManager::ThreadType lane) noexcept
+		{
+			return static_cast<std::size_t>(lane);
+		}
+
+		template<typename T>
+		void update_max(std::atomic<T>& target, T value) noexcept
+		{
+			T current = target.load(std::memory_order_relaxed);
+			while (value > current &&
+				   !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+			{
+			}
+		}
+
+		// Single-writer counter update: no locked RMW on the hot path
+		void bump(std::atomic<std::uint64_t>& counter, std::uint64_t delta) noexcept
+		{
+			counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+		}
+
+		// Single-writer maximum, the counterpart of bump()
+		template<typename T>
+		void raise(std::atomic<T>& target, T value) noexcept
+		{
+			if (value > target.load(std::memory_order_relaxed))
+			{
+				target.store(value, std::memory_order_relaxed);
+			}
+		}
+
+		std::size_t latency_bucket(std::uint64_t wait_ns) noexcept
+		{
+			return std::min<std::size_t>(std::bit_width(wait_ns), ThreadManager::LATENCY_BUCKETS - 1);
+		}
+	}
+
 	ThreadManager::ThreadManager() 
-		: m_running(true) 
+		: ThreadManager(PoolConfig{}) 
 	{
-		unsigned num_workers = std::thread::hardware_concurrency();
-		if (num_workers == 0) num_workers = 2;
+	}
 
-		for (unsigned i = 0; i < num_workers; ++i)
+	ThreadManager::ThreadManager(PoolConfig config) 
+		: m_running(true), m_topology(CpuTopology::detect()),
+		  m_mode(config.mode), m_virtual_origin(std::chrono::steady_clock::now())
+	{
+		if (m_mode == ExecutionMode::DETERMINISTIC)
+		{
+			// One queue drained by step_deterministic(), no worker threads
+			m_queues.push_back(std::make_unique<WorkerQueues>());
+			m_worker_nodes.push_back(0);
+			build_steal_order();
+
+			LOG_INFO("ThreadManager: deterministic mode, all loops and tasks run on the stepping thread");
+			return;
+		}
+
+		const std::vector<int> worker_cpus = plan_workers(config);
+		const std::size_t num_workers = worker_cpus.size();
+
+		// Queues must exist before any worker can steal from them
+		m_queues.reserve(num_workers);
+		for (std::size_t i = 0; i < num_workers; ++i)
+		{
+			m_queues.push_back(std::make_unique<WorkerQueues>());
+			m_worker_nodes.push_back(worker_cpus[i] >= 0 ? m_topology.node_of(worker_cpus[i]) : 0);
+		}
+		build_steal_order();
+
+		for (std::size_t i = 0; i < num_workers; ++i)
 		{
 			m_threads.emplace_back(
 		        ThreadType::MAIN,
-		        std::thread(&ThreadManager::worker_loop, this),
+		        std::thread(&ThreadManager::worker_loop, this, i),
+		        true,
 		        true
 		    );
+
+			if (worker_cpus[i] >= 0)
+			{
+				ThreadSchedulingConfig placement;
+				placement.cpus = { worker_cpus[i] };
+				apply_thread_scheduling(m_threads.back().thread, placement, i, "worker");
+			}
 		}
+
+		LOG_INFO("ThreadManager:", num_workers, "workers,", m_topology.physical_core_count(), "physical cores,",
+				 m_topology.logical_cpu_count(), "logical CPUs,", m_topology.node_count(), "NUMA nodes",
+				 m_topology.is_detected() ? "" : "(topology unavailable, assuming flat layout)");
+	}
+
+	std::vector<int> ThreadManager::plan_workers(const PoolConfig& config)
+	{
+	    const std::vector<CpuInfo> order = m_topology.placement_order(config.use_smt_siblings);
+	    const std::vector<CpuInfo> cores = m_topology.placement_order(false);
+
+	    // The first cores (lowest node) go to the pinned dedicated loops, as
+	    // long as MIN_WORKERS cores are left for the pool
+	    const std::size_t reserved = std::min(config.reserved_cores,
+	        cores.size() > MIN_WORKERS ? cores.size() - MIN_WORKERS : 0);
+	    for (std::size_t i = 0; i < reserved; ++i)
+	    {
+	        m_reserved_cpus.push_back(cores[i].id);
+	    }
+
+	    std::vector<int> free_cpus;
+	    for (const auto& cpu : order)
+	    {
+	        const bool is_reserved = std::any_of(cores.begin(), cores.begin() + static_cast<std::ptrdiff_t>(reserved),
+	            [&cpu](const CpuInfo& core) { return core.core == cpu.core; });
+	        if (!is_reserved) free_cpus.push_back(cpu.id);
+	    }
+
+	    const std::size_t count = config.worker_count > 0
+	        ? config.worker_count
+	        : std::max(MIN_WORKERS, free_cpus.size());
+
+	    // Pin only as long as there is a free CPU per worker; oversubscribed
+	    // pools (explicit worker_count) leave the OS to balance them
+	    const bool pin = config.pin_workers && m_topology.is_detected() && count <= free_cpus.size();
+
+	    std::vector<int> worker_cpus(count, -1);
+	    for (std::size_t i = 0; pin && i < count; ++i)
+	    {
+	        worker_cpus[i] = free_cpus[i];
+	    }
+	    return worker_cpus;
+	}
+
+	void ThreadManager::build_steal_order()
+	{
+	    const std::size_t count = m_queues.size();
+	    m_steal_order.assign(count, {});
+
+	    for (std::size_t index = 0; index < count; ++index)
+	    {
+	        auto& victims = m_steal_order[index];
+	        victims.reserve(count - 1);
+
+	        // Same node first, then remote nodes; both rotated to spread thieves
+	        for (const bool local : { true, false })
+	        {
+	            for (std::size_t i = 1; i < count; ++i)
+	            {
+	                const std::size_t victim = (index + i) % count;
+	                if ((m_worker_nodes[victim] == m_worker_nodes[index]) == local)
+	                {
+	                    victims.push_back(victim);
+	                }
+	            }
+	        }
+	    }
+	}
+
+	int ThreadManager::worker_node(std::size_t worker) const noexcept
+	{
+	    return worker < m_worker_nodes.size() ? m_worker_nodes[worker] : 0;
 	}
 
 	ThreadManager::~ThreadManager() { stop_all(); }
@@ -25,6 +198,9 @@ namespace RoboTact::Core
 	    if (!m_running) return;
 	    
 	    LOG_INFO("Stopping all threads gracefully...");
+
+	    // No more timed resumptions into a pool that is shutting down
+	    m_timer_wheel.stop();
 	    
 	    // Signal task workers to stop
 	    {
@@ -36,8 +212,14 @@ namespace RoboTact::Core
 	    // Signal other threads
 	    m_running = false;
 	    
-	    // Join all threads
-	    for (auto& thread_info : m_threads) 
+	    // Join all threads (outside the lock, a joining thread may still configure)
+	    std::vector<ThreadInfo> threads;
+	    {
+	        std::lock_guard<std::mutex> lock(m_threads_mutex);
+	        threads.swap(m_threads);
+	    }
+
+	    for (auto& thread_info : threads) 
 	    {
 	        if (thread_info.thread.joinable()) 
 	        {
@@ -45,8 +227,36 @@ namespace RoboTact::Core
 	            thread_info.thread.join();
 	        }
 	    }
-	    
-	    m_threads.clear();
+
+	    discard_queued_tasks();
+	}
+
+	void ThreadManager::discard_queued_tasks()
+	{
+	    // Left behind by an emergency stop or pushed after the workers exited.
+	    // Destroying them lets RAII tasks (bulk items, graph nodes) settle their
+	    // waiters instead of keeping them blocked until the manager is gone.
+	    std::size_t discarded = 0;
+	    for (auto& queues : m_queues)
+	    {
+	        for (std::size_t lane = 0; lane < LANE_COUNT; ++lane)
+	        {
+	            QueuedTask task;
+	            while (queues->lanes[lane].try_steal(task))
+	            {
+	                m_lanes[lane].depth.fetch_sub(1, std::memory_order_relaxed);
+	                m_lanes[lane].cancelled.fetch_add(1, std::memory_order_relaxed);
+	                m_pending_tasks.fetch_sub(1, std::memory_order_relaxed);
+	                task = QueuedTask{};
+	                ++discarded;
+	            }
+	        }
+	    }
+
+	    if (discarded > 0)
+	    {
+	        LOG_WARNING("Discarded", discarded, "queued task(s) on stop");
+	    }
 	}
 
 	void ThreadManager::emergency_stop() 
@@ -61,16 +271,85 @@ namespace RoboTact::Core
     	return m_running && !m_emergency_stop;
 	}
 
+	void ThreadManager::configure_thread_type(ThreadType type, ThreadSchedulingConfig config)
+	{
+	    std::lock_guard<std::mutex> lock(m_threads_mutex);
+	    m_scheduling[lane_index(type)] = std::move(config);
+
+	    std::size_t group_index = 0;
+	    for (auto& thread_info : m_threads)
+	    {
+	        if (thread_info.is_worker || thread_info.type != type) continue;
+	        apply_thread_scheduling(thread_info.thread, m_scheduling[lane_index(type)],
+	                                group_index++, thread_type_name(type));
+	    }
+	}
+
+	void ThreadManager::configure_workers(ThreadSchedulingConfig config)
+	{
+	    std::lock_guard<std::mutex> lock(m_threads_mutex);
+	    m_worker_scheduling = std::move(config);
+
+	    std::size_t group_index = 0;
+	    for (auto& thread_info : m_threads)
+	    {
+	        if (!thread_info.is_worker) continue;
+	        apply_thread_scheduling(thread_info.thread, m_worker_scheduling,
+	                                group_index++, "worker");
+	    }
+	}
+
+	bool ThreadManager::lock_memory()
+	{
+	    return lock_process_memory();
+	}
+
+	void ThreadManager::set_wait_strategy(WaitStrategy strategy) noexcept
+	{
+	    m_max_spin.store(strategy.max_spin, std::memory_order_relaxed);
+	    m_yield_count.store(strategy.yield_count, std::memory_order_relaxed);
+	    m_adaptive_spin.store(strategy.adaptive, std::memory_order_relaxed);
+	}
+
+	ThreadManager::WaitStrategy ThreadManager::get_wait_strategy() const noexcept
+	{
+	    WaitStrategy strategy;
+	    strategy.max_spin = m_max_spin.load(std::memory_order_relaxed);
+	    strategy.yield_count = m_yield_count.load(std::memory_order_relaxed);
+	    strategy.adaptive = m_adaptive_spin.load(std::memory_order_relaxed);
+	    return strategy;
+	}
+
+	const char* ThreadManager::thread_type_name(ThreadType type) noexcept
+	{
+	    switch (type)
+	    {
+	        case ThreadType::MAIN:       return "MAIN";
+	        case ThreadType::SIMULATION: return "SIMULATION";
+	        case ThreadType::IO:         return "IO";
+	        default:                     return "UNKNOWN";
+	    }
+	}
+
 	void ThreadManager::start_thread(ThreadType type, std::function<void()> func) 
 	{
+	    if (is_deterministic())
+	    {
+	        register_deterministic_loop(type, std::move(func), std::chrono::nanoseconds::zero());
+	        return;
+	    }
+
+	    std::lock_guard<std::mutex> lock(m_threads_mutex);
 	    m_threads.emplace_back(
 	        type,
 		    std::thread([this, func, type]() 
 		    {
+		        PROFILE_THREAD(thread_type_name(type));
 		        while (should_continue())
 		        {
 		            try {
 		                func();
+		                ScratchArena::current().reset();
 		            } catch (const std::exception& e) {
 		                LOG_ERROR("Exception in thread: {}", e.what());
 		                if (type == ThreadType::MAIN) {
@@ -82,34 +361,747 @@ namespace RoboTact::Core
 		    }),
 	        true
 	    );
+
+	    const ThreadSchedulingConfig& config = m_scheduling[lane_index(type)];
+	    if (!config.is_default())
+	    {
+	        const auto group_index = static_cast<std::size_t>(std::count_if(
+	            m_threads.begin(), m_threads.end(),
+	            [type](const ThreadInfo& info) { return !info.is_worker && info.type == type; })) - 1;
+	        apply_thread_scheduling(m_threads.back().thread, config, group_index, thread_type_name(type));
+	    }
+	}
+
+	std::size_t ThreadManager::worker_count() const noexcept
+	{
+	    // The deterministic queue has no thread of its own
+	    return is_deterministic() ? 0 : m_queues.size();
+	}
+
+	ThreadManager::LaneStats ThreadManager::get_lane_stats(ThreadType lane) const noexcept
+	{
+	    const LaneCounters& counters = m_lanes[lane_index(lane)];
+
+	    LaneStats stats;
+	    stats.queue_depth = counters.depth.load(std::memory_order_relaxed);
+	    stats.enqueued = counters.enqueued.load(std::memory_order_relaxed);
+	    stats.cancelled = counters.cancelled.load(std::memory_order_relaxed);
+	    // A peak is only seen once a task leaves the lane; count a current one too
+	    stats.depth_high_water = stats.queue_depth;
+
+	    // Wait statistics live with the threads that ran the tasks
+	    std::uint64_t total_wait_ns = 0;
+	    std::uint64_t max_wait_ns = 0;
+	    const auto accumulate = [&](const WorkerCounters& worker)
+	    {
+	        const LaneWaitCounters& waits = worker.lanes[lane_index(lane)];
+	        stats.depth_high_water = std::max(stats.depth_high_water, waits.high_water.load(std::memory_order_relaxed));
+	        stats.dequeued += waits.dequeued.load(std::memory_order_relaxed);
+	        total_wait_ns += waits.wait_ns.load(std::memory_order_relaxed);
+	        max_wait_ns = std::max(max_wait_ns, waits.max_wait_ns.load(std::memory_order_relaxed));
+	        for (std::size_t bucket = 0; bucket < LATENCY_BUCKETS; ++bucket)
+	        {
+	            stats.wait_histogram[bucket] += waits.wait_histogram[bucket].load(std::memory_order_relaxed);
+	        }
+	    };
+	    for (const auto& queues : m_queues) accumulate(queues->counters);
+	    accumulate(m_external_counters);
+
+	    stats.average_wait_ms = stats.dequeued ? total_wait_ns / 1e6 / static_cast<double>(stats.dequeued) : 0.0;
+	    stats.max_wait_ms = max_wait_ns / 1e6;
+	    return stats;
+	}
+
+	double ThreadManager::LaneStats::wait_percentile_ms(double p) const noexcept
+	{
+	    std::uint64_t total = 0;
+	    for (const auto count : wait_histogram) total += count;
+	    if (total == 0) return 0.0;
+
+	    const auto rank = static_cast<std::uint64_t>(std::clamp(p, 0.0, 1.0) * static_cast<double>(total - 1));
+	    std::uint64_t seen = 0;
+	    for (std::size_t bucket = 0; bucket < LATENCY_BUCKETS; ++bucket)
+	    {
+	        seen += wait_histogram[bucket];
+	        if (seen > rank)
+	        {
+	            // Bucket k holds waits below 2^k ns; the last bucket is open-ended
+	            return bucket + 1 < LATENCY_BUCKETS
+	                ? std::min(static_cast<double>(std::uint64_t{1} << bucket) / 1e6, max_wait_ms)
+	                : max_wait_ms;
+	        }
+	    }
+	    return max_wait_ms;
+	}
+
+	void ThreadManager::reset_lane_stats() noexcept
+	{
+	    for (auto& counters : m_lanes)
+	    {
+	        counters.enqueued.store(0, std::memory_order_relaxed);
+	        counters.cancelled.store(0, std::memory_order_relaxed);
+	    }
+
+	    const auto reset = [](WorkerCounters& worker)
+	    {
+	        for (auto& waits : worker.lanes)
+	        {
+	            waits.high_water.store(0, std::memory_order_relaxed);
+	            waits.dequeued.store(0, std::memory_order_relaxed);
+	            waits.wait_ns.store(0, std::memory_order_relaxed);
+	            waits.max_wait_ns.store(0, std::memory_order_relaxed);
+	            for (auto& bucket : waits.wait_histogram) bucket.store(0, std::memory_order_relaxed);
+	        }
+	    };
+	    for (auto& queues : m_queues) reset(queues->counters);
+	    reset(m_external_counters);
+	}
+
+	ThreadManager::SchedulerStats ThreadManager::get_stats() const
+	{
+	    SchedulerStats stats;
+	    stats.pending_tasks = m_pending_tasks.load(std::memory_order_relaxed);
+	    stats.idle_pending = m_idle_pending.load(std::memory_order_relaxed);
+	    stats.idle_executed = m_idle_executed.load(std::memory_order_relaxed);
+
+	    for (std::size_t lane = 0; lane < LANE_COUNT; ++lane)
+	    {
+	        stats.lanes[lane] = get_lane_stats(static_cast<ThreadType>(lane));
+	    }
+
+	    stats.workers.reserve(worker_count());
+	    for (std::size_t index = 0; index < worker_count(); ++index)
+	    {
+	        const WorkerCounters& counters = m_queues[index]->counters;
+
+	        WorkerStats worker;
+	        worker.node = worker_node(index);
+	        worker.tasks_executed = counters.tasks_executed.load(std::memory_order_relaxed);
+	        worker.steals = counters.steals.load(std::memory_order_relaxed);
+	        worker.busy_ms = counters.busy_ns.load(std::memory_order_relaxed) / 1e6;
+	        worker.idle_ms = counters.idle_ns.load(std::memory_order_relaxed) / 1e6;
+	        stats.workers.push_back(worker);
+	    }
+	    return stats;
+	}
+
+	void ThreadManager::reset_stats() noexcept
+	{
+	    reset_lane_stats();
+	    m_idle_executed.store(0, std::memory_order_relaxed);
+
+	    for (auto& queues : m_queues)
+	    {
+	        WorkerCounters& counters = queues->counters;
+	        counters.tasks_executed.store(0, std::memory_order_relaxed);
+	        counters.steals.store(0, std::memory_order_relaxed);
+	        counters.busy_ns.store(0, std::memory_order_relaxed);
+	        counters.idle_ns.store(0, std::memory_order_relaxed);
+	    }
+	}
+
+	void ThreadManager::log_stats() const
+	{
+	    const SchedulerStats stats = get_stats();
+
+	    for (std::size_t lane = 0; lane < LANE_COUNT; ++lane)
+	    {
+	        const LaneStats& l = stats.lanes[lane];
+	        std::ostringstream line;
+	        line << std::fixed << std::setprecision(3)
+	             << "depth " << l.queue_depth << " (max " << l.depth_high_water << ")"
+	             << " enqueued " << l.enqueued << " started " << l.dequeued << " cancelled " << l.cancelled
+	             << " wait ms avg " << l.average_wait_ms << " p50 " << l.wait_percentile_ms(0.50)
+	             << " p99 " << l.wait_percentile_ms(0.99) << " max " << l.max_wait_ms;
+	        LOG_DEBUG("Lane", thread_type_name(static_cast<ThreadType>(lane)), ":", line.str());
+	    }
+
+	    LOG_DEBUG("Idle lane: pending", stats.idle_pending, "executed", stats.idle_executed);
+
+	    for (std::size_t index = 0; index < stats.workers.size(); ++index)
+	    {
+	        const WorkerStats& w = stats.workers[index];
+	        std::ostringstream line;
+	        line << std::fixed << std::setprecision(1)
+	             << "node " << w.node << " tasks " << w.tasks_executed << " steals " << w.steals
+	             << " busy " << w.busy_ms << " ms idle " << w.idle_ms << " ms ("
+	             << w.utilization() * 100.0 << "% utilized)";
+	        LOG_DEBUG("Worker", index, ":", line.str());
+	    }
+	}
+
+	bool ThreadManager::log_stats_if_due(std::chrono::milliseconds interval)
+	{
+	    const std::int64_t now = now_ns();
+	    std::int64_t last = m_last_stats_log_ns.load(std::memory_order_relaxed);
+
+	    if (now - last < std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count()) return false;
+	    if (!m_last_stats_log_ns.compare_exchange_strong(last, now, std::memory_order_relaxed)) return false;
+
+	    log_stats();
+	    return true;
+	}
+
+	std::int64_t ThreadManager::now_ns() noexcept
+	{
+	    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+	        std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	void ThreadManager::push_task(ThreadType lane, TaskFunction&& work)
+	{
+	    if (m_stop_tasks)
+	    {
+	        LOG_ERROR_EVERY_MS(1000, "enqueue on stopped ThreadManager");
+	    }
+
+	    // Counted before the task is visible: a worker may take it and
+	    // decrement the count right after the push
+	    m_pending_tasks.fetch_add(1);
+	    try {
+	        enqueue_task(lane, std::move(work));
+	    } catch (...) {
+	        m_pending_tasks.fetch_sub(1);
+	        throw;
+	    }
+	    wake_workers(1);
+	}
+
+	bool ThreadManager::try_push_task(ThreadType lane, TaskFunction&& work)
+	{
+	    // Counted before the stop check: a worker that has seen m_stop_tasks
+	    // then also sees this task and runs it before exiting
+	    m_pending_tasks.fetch_add(1);
+	    if (m_stop_tasks)
+	    {
+	        m_pending_tasks.fetch_sub(1);
+	        return false;
+	    }
+
+	    try {
+	        enqueue_task(lane, std::move(work));
+	    } catch (...) {
+	        m_pending_tasks.fetch_sub(1);
+	        throw;
+	    }
+	    wake_workers(1);
+	    return true;
+	}
+
+	void ThreadManager::enqueue_task(ThreadType lane, TaskFunction&& work)
+	{
+	    // Workers keep their own spawns local; external callers round-robin
+	    const std::size_t target = (t_worker_owner == this)
+	        ? t_worker_index
+	        : m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+
+	    LaneCounters& counters = m_lanes[lane_index(lane)];
+	    counters.enqueued.fetch_add(1, std::memory_order_relaxed);
+	    counters.depth.fetch_add(1, std::memory_order_relaxed);
+
+	    try {
+	        m_queues[target]->lanes[lane_index(lane)].push(QueuedTask{ std::move(work), now_ns() });
+	    } catch (...) {
+	        counters.depth.fetch_sub(1, std::memory_order_relaxed);
+	        counters.enqueued.fetch_sub(1, std::memory_order_relaxed);
+	        throw;
+	    }
 	}
 
-	void ThreadManager::worker_loop() 
+	void ThreadManager::wake_workers(std::size_t count)
 	{
-	    while (should_continue()) 
+	    // Pairs with the sleeping counter increment in worker_loop: either the
+	    // worker sees the pending task or we see the sleeper and notify it.
+	    const std::size_t sleeping = m_sleeping_workers.load();
+	    if (sleeping == 0) return;
+
+	    {
+	        std::lock_guard<std::mutex> lock(m_task_mutex);
+	    }
+
+	    if (count >= sleeping)
 	    {
-	        std::function<void()> task;
-	        
+	        m_task_cv.notify_all();
+	        return;
+	    }
+	    for (std::size_t i = 0; i < count; ++i)
+	    {
+	        m_task_cv.notify_one();
+	    }
+	}
+
+	bool ThreadManager::begin_bulk_push(ThreadType lane, std::size_t count, std::size_t& first_queue)
+	{
+	    // Counted before the stop check and before any task of the batch is
+	    // visible (see try_push_task and push_task)
+	    m_pending_tasks.fetch_add(count);
+	    if (m_stop_tasks)
+	    {
+	        m_pending_tasks.fetch_sub(count);
+	        LOG_ERROR_EVERY_MS(1000, "bulk enqueue on stopped ThreadManager, batch cancelled");
+	        return false;
+	    }
+
+	    LaneCounters& counters = m_lanes[lane_index(lane)];
+	    counters.enqueued.fetch_add(count, std::memory_order_relaxed);
+	    counters.depth.fetch_add(count, std::memory_order_relaxed);
+
+	    // Workers start the batch on their own deque, external callers rotate
+	    first_queue = (t_worker_owner == this)
+	        ? t_worker_index
+	        : m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+	    return true;
+	}
+
+	void ThreadManager::finish_bulk_push(ThreadType lane, std::size_t count, std::size_t pushed)
+	{
+	    // A push that threw part-way: uncount what never reached a deque
+	    if (const std::size_t missing = count - pushed)
+	    {
+	        LaneCounters& counters = m_lanes[lane_index(lane)];
+	        counters.enqueued.fetch_sub(missing, std::memory_order_relaxed);
+	        counters.depth.fetch_sub(missing, std::memory_order_relaxed);
+	        m_pending_tasks.fetch_sub(missing);
+	    }
+
+	    if (pushed > 0) wake_workers(pushed);
+	}
+
+	bool ThreadManager::spin_for_task(std::uint32_t& spin_budget)
+	{
+	    // Spinning only reads shared state, so workers that are busy-waiting
+	    // do not count as sleepers and producers never notify them.
+	    const std::uint32_t max_spin = m_max_spin.load(std::memory_order_relaxed);
+	    const bool adaptive = m_adaptive_spin.load(std::memory_order_relaxed);
+	    const std::uint32_t budget = adaptive ? std::min(spin_budget, max_spin) : max_spin;
+
+	    const auto work_available = [this] {
+	        return m_pending_tasks.load(std::memory_order_relaxed) > 0;
+	    };
+	    // On shutdown fall through to the parking path, which handles exit
+	    const auto stopping = [this] {
+	        return m_stop_tasks.load(std::memory_order_relaxed);
+	    };
+
+	    // Work that shows up while waiting means the budget was too short
+	    const auto grow = [&] {
+	        spin_budget = std::min(std::max(budget, MIN_SPIN) * 2, std::max(max_spin, MIN_SPIN));
+	        return true;
+	    };
+
+	    for (std::uint32_t i = 0; i < budget && !stopping(); ++i)
+	    {
+	        if (work_available()) return grow();
+	        cpu_relax();
+	    }
+
+	    const std::uint32_t yield_count = m_yield_count.load(std::memory_order_relaxed);
+	    for (std::uint32_t i = 0; i < yield_count && !stopping(); ++i)
+	    {
+	        if (work_available()) return grow();
+	        std::this_thread::yield();
+	    }
+
+	    // Nothing showed up: back off so an idle pool stops burning CPU
+	    spin_budget = std::max(budget / 2, MIN_SPIN);
+	    return work_available() && !stopping();
+	}
+
+	bool ThreadManager::try_acquire_task(std::size_t index, QueuedTask& task, std::size_t& lane_out)
+	{
+	    // Strict priority, except that every STARVATION_INTERVAL-th dispatch
+	    // scans from the lowest lane so IO work always keeps making progress.
+	    const bool reverse = (t_dispatch_count % STARVATION_INTERVAL) == STARVATION_INTERVAL - 1;
+
+	    for (std::size_t step = 0; step < LANE_COUNT; ++step)
+	    {
+	        const std::size_t lane = reverse ? LANE_COUNT - 1 - step : step;
+	        if (m_lanes[lane].depth.load(std::memory_order_relaxed) == 0) continue;
+
+	        if (try_acquire_from_lane(index, lane, task))
 	        {
+	            ++t_dispatch_count;
+	            lane_out = lane;
+
+	            // Depth only drops here, so every peak passes through a dequeue
+	            note_dequeued(lane, m_lanes[lane].depth.fetch_sub(1, std::memory_order_relaxed));
+	            m_pending_tasks.fetch_sub(1, std::memory_order_relaxed);
+	            return true;
+	        }
+	    }
+	    return false;
+	}
+
+	bool ThreadManager::try_acquire_from_lane(std::size_t index, std::size_t lane, QueuedTask& task)
+	{
+	    // Deterministic mode: FIFO within a lane (oldest first), lanes in the
+	    // priority order try_acquire_task() scans them in
+	    if (is_deterministic()) return m_queues[index]->lanes[lane].try_steal(task);
+
+	    if (m_queues[index]->lanes[lane].try_pop(task)) return true;
+
+	    for (const std::size_t victim : m_steal_order[index])
+	    {
+	        if (m_queues[victim]->lanes[lane].try_steal(task))
+	        {
+	            if (t_worker_owner == this && t_worker_index == index)
+	            {
+	                bump(m_queues[index]->counters.steals, 1);
+	            }
+	            return true;
+	        }
+	    }
+	    return false;
+	}
+
+	bool ThreadManager::try_run_pending_task()
+	{
+	    // Outsiders start at the round-robin cursor to spread their probing
+	    const std::size_t index = (t_worker_owner == this)
+	        ? t_worker_index
+	        : m_next_queue.load(std::memory_order_relaxed) % m_queues.size();
+
+	    QueuedTask task;
+	    std::size_t lane = 0;
+	    if (!try_acquire_task(index, task, lane)) return false;
+
+	    const std::int64_t start = now_ns();
+	    if (run_task(task))
+	    {
+	        note_completed(lane, task.enqueue_ns, start);
+	    }
+	    return true;
+	}
+
+	bool ThreadManager::run_task(QueuedTask& task)
+	{
+	    PROFILE_SCOPE("task");
+	    ScratchArena::Scope scratch;
+
+	    if (t_worker_owner == this)
+	    {
+	        bump(m_queues[t_worker_index]->counters.tasks_executed, 1);
+	    }
+
+	    // Saved and restored, the task may itself help run other tasks
+	    const bool previous_cancelled = t_task_cancelled;
+	    t_task_cancelled = false;
+
+	    try {
+	        task.work();
+	    } catch (const std::exception& e) {
+	        LOG_ERROR("Exception in task: {}", e.what());
+	    }
+
+	    const bool cancelled = t_task_cancelled;
+	    t_task_cancelled = previous_cancelled;
+	    return !cancelled;
+	}
+
+	void ThreadManager::note_dequeued(std::size_t lane, std::size_t depth) noexcept
+	{
+	    if (t_worker_owner == this)
+	    {
+	        raise(m_queues[t_worker_index]->counters.lanes[lane].high_water, depth);
+	    }
+	    else
+	    {
+	        update_max(m_external_counters.lanes[lane].high_water, depth);
+	    }
+	}
+
+	void ThreadManager::note_completed(std::size_t lane, std::int64_t enqueue_ns, std::int64_t start_ns) noexcept
+	{
+	    const auto wait = static_cast<std::uint64_t>(std::max<std::int64_t>(0, start_ns - enqueue_ns));
+
+	    if (t_worker_owner == this)
+	    {
+	        LaneWaitCounters& waits = m_queues[t_worker_index]->counters.lanes[lane];
+	        bump(waits.dequeued, 1);
+	        bump(waits.wait_ns, wait);
+	        raise(waits.max_wait_ns, wait);
+	        bump(waits.wait_histogram[latency_bucket(wait)], 1);
+	        return;
+	    }
+
+	    // Helping threads have no block of their own and may run concurrently
+	    LaneWaitCounters& waits = m_external_counters.lanes[lane];
+	    waits.dequeued.fetch_add(1, std::memory_order_relaxed);
+	    waits.wait_ns.fetch_add(wait, std::memory_order_relaxed);
+	    update_max(waits.max_wait_ns, wait);
+	    waits.wait_histogram[latency_bucket(wait)].fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void ThreadManager::note_cancelled(ThreadType lane) noexcept
+	{
+	    m_lanes[lane_index(lane)].cancelled.fetch_add(1, std::memory_order_relaxed);
+	    t_task_cancelled = true;
+	}
+
+	void ThreadManager::push_idle_task(TaskFunction&& work)
+	{
+	    m_idle_queue.push(QueuedTask{ std::move(work), now_ns() });
+	    m_idle_pending.fetch_add(1);
+	    wake_workers(1);
+	}
+
+	bool ThreadManager::run_idle_task(std::int64_t deadline_ns, bool yield_on_pending)
+	{
+	    QueuedTask task;
+	    if (!m_idle_queue.try_steal(task)) return false;
+	    m_idle_pending.fetch_sub(1, std::memory_order_relaxed);
+
+	    // Saved and restored, an idle task may itself help run other tasks
+	    const ThreadManager* const previous_owner = t_idle_owner;
+	    const bool previous_yield_on_pending = t_idle_yield_on_pending;
+	    const std::int64_t previous_deadline = t_idle_deadline_ns;
+	    t_idle_owner = this;
+	    t_idle_yield_on_pending = yield_on_pending;
+	    t_idle_deadline_ns = deadline_ns;
+
+	    run_task(task);
+
+	    t_idle_owner = previous_owner;
+	    t_idle_yield_on_pending = previous_yield_on_pending;
+	    t_idle_deadline_ns = previous_deadline;
+	    m_idle_executed.fetch_add(1, std::memory_order_relaxed);
+	    return true;
+	}
+
+	std::size_t ThreadManager::run_idle_tasks(std::chrono::nanoseconds budget)
+	{
+	    if (is_deterministic())
+	    {
+	        // A wall-clock budget would make the outcome timing dependent:
+	        // give every queued slice exactly one turn instead
+	        const std::size_t queued = m_idle_pending.load(std::memory_order_relaxed);
+	        std::size_t executed = 0;
+	        while (executed < queued && run_idle_task(std::numeric_limits<std::int64_t>::max(), false))
+	        {
+	            ++executed;
+	        }
+	        return executed;
+	    }
+
+	    const std::int64_t deadline = now_ns() + budget.count();
+
+	    // Frame slack is the main thread's own time, so only the budget ends it
+	    std::size_t executed = 0;
+	    while (now_ns() < deadline && run_idle_task(deadline, false))
+	    {
+	        ++executed;
+	    }
+	    return executed;
+	}
+
+	bool ThreadManager::should_yield() noexcept
+	{
+	    if (t_idle_owner)
+	    {
+	        // Shutting down: slices should wrap up so the workers can exit
+	        if (t_idle_owner->m_stop_tasks.load(std::memory_order_relaxed)) return true;
+
+	        if (t_idle_yield_on_pending && t_idle_owner->m_pending_tasks.load(std::memory_order_relaxed) > 0)
+	        {
+	            return true;
+	        }
+	    }
+	    return t_idle_deadline_ns != std::numeric_limits<std::int64_t>::max() && now_ns() >= t_idle_deadline_ns;
+	}
+
+	std::size_t ThreadManager::auto_grain(std::size_t count) const noexcept
+	{
+	    // ~4 chunks per participant balances load without drowning in overhead
+	    const std::size_t target_chunks = (worker_count() + 1) * 4;
+	    return std::max<std::size_t>(1, (count + target_chunks - 1) / target_chunks);
+	}
+
+	void ThreadManager::start_periodic_thread(ThreadType type, PeriodicConfig config, std::function<void()> tick)
+	{
+	    if (is_deterministic())
+	    {
+	        register_deterministic_loop(type, std::move(tick), std::max(config.period, std::chrono::nanoseconds(1)));
+	        return;
+	    }
+
+	    auto runner = std::make_shared<PeriodicRunner>(config);
+	    {
+	        std::lock_guard<std::mutex> lock(m_threads_mutex);
+	        m_periodic_runners[lane_index(type)] = runner;
+	    }
+
+	    // The runner only returns once should_continue() turns false (or tick
+	    // throws, in which case start_thread logs and restarts it)
+	    start_thread(type, [this, runner, tick = std::move(tick)]()
+	    {
+	        runner->run([this]() { return should_continue(); }, [&tick]()
+	        {
+	            tick();
+	            ScratchArena::current().reset();
+	        });
+	    });
+	}
+
+	PeriodicStats ThreadManager::get_periodic_stats(ThreadType type)
+	{
+	    std::shared_ptr<PeriodicRunner> runner;
+	    {
+	        std::lock_guard<std::mutex> lock(m_threads_mutex);
+	        for (const auto& loop : m_deterministic_loops)
+	        {
+	            if (loop->type == type && loop->period.count() > 0) return loop->stats;
+	        }
+	        runner = m_periodic_runners[lane_index(type)];
+	    }
+	    return runner ? runner->get_stats() : PeriodicStats{};
+	}
+
+	std::chrono::steady_clock::time_point ThreadManager::now() const noexcept
+	{
+	    if (!is_deterministic()) return std::chrono::steady_clock::now();
+	    return m_virtual_origin + std::chrono::nanoseconds(m_virtual_time_ns.load(std::memory_order_relaxed));
+	}
+
+	void ThreadManager::register_deterministic_loop(ThreadType type, std::function<void()> body,
+	                                                std::chrono::nanoseconds period)
+	{
+	    auto loop = std::make_unique<DeterministicLoop>();
+	    loop->type = type;
+	    loop->body = std::move(body);
+	    loop->period = period;
+	    // Like PeriodicRunner, the first tick is due immediately
+	    loop->next_deadline = std::chrono::nanoseconds(m_virtual_time_ns.load(std::memory_order_relaxed));
+
+	    std::lock_guard<std::mutex> lock(m_threads_mutex);
+	    m_deterministic_loops.push_back(std::move(loop));
+	}
+
+	bool ThreadManager::run_deterministic_body(DeterministicLoop& loop)
+	{
+	    try {
+	        loop.body();
+	        ScratchArena::current().reset();
+	    } catch (const std::exception& e) {
+	        LOG_ERROR("Exception in thread: {}", e.what());
+	        if (loop.type == ThreadType::MAIN) {
+	            emergency_stop();
+	            return false;
+	        }
+	    }
+	    return should_continue();
+	}
+
+	void ThreadManager::drain_deterministic_tasks()
+	{
+	    while (should_continue() && try_run_pending_task())
+	    {
+	    }
+	}
+
+	void ThreadManager::step_deterministic(std::chrono::nanoseconds frame)
+	{
+	    if (!is_deterministic() || !should_continue()) return;
+
+	    const std::chrono::nanoseconds target(m_virtual_time_ns.load(std::memory_order_relaxed) + frame.count());
+	    drain_deterministic_tasks();
+
+	    // Periodic ticks due within the frame, earliest deadline first
+	    while (should_continue())
+	    {
+	        DeterministicLoop* next = nullptr;
+	        {
+	            std::lock_guard<std::mutex> lock(m_threads_mutex);
+	            for (const auto& loop : m_deterministic_loops)
+	            {
+	                if (loop->period.count() == 0 || loop->next_deadline > target) continue;
+	                // Strict comparison: ties go to the loop registered first
+	                if (!next || loop->next_deadline < next->next_deadline) next = loop.get();
+	            }
+	            if (!next) break;
+
+	            m_virtual_time_ns.store(std::max(m_virtual_time_ns.load(std::memory_order_relaxed),
+	                                             next->next_deadline.count()), std::memory_order_relaxed);
+	            next->next_deadline += next->period;
+	            ++next->stats.ticks;
+	        }
+
+	        if (!run_deterministic_body(*next)) return;
+	        drain_deterministic_tasks();
+	    }
+
+	    // Plain loops get one iteration per step, in registration order
+	    for (std::size_t index = 0; should_continue(); ++index)
+	    {
+	        DeterministicLoop* loop = nullptr;
+	        {
+	            std::lock_guard<std::mutex> lock(m_threads_mutex);
+	            if (index >= m_deterministic_loops.size()) break;
+	            loop = m_deterministic_loops[index].get();
+	        }
+	        if (loop->period.count() != 0) continue;
+
+	        if (!run_deterministic_body(*loop)) return;
+	        drain_deterministic_tasks();
+	    }
+
+	    m_virtual_time_ns.store(target.count(), std::memory_order_relaxed);
+	}
+
+	void ThreadManager::worker_loop(std::size_t index) 
+	{
+	    t_worker_owner = this;
+	    t_worker_index = index;
+	    PROFILE_THREAD("worker " + std::to_string(index));
+
+	    std::uint32_t spin_budget = INITIAL_SPIN;
+
+	    WorkerCounters& counters = m_queues[index]->counters;
+	    std::int64_t idle_since = now_ns();
+
+	    while (!m_emergency_stop) 
+	    {
+	        QueuedTask task;
+	        std::size_t lane = 0;
+
+	        if (!try_acquire_task(index, task, lane))
+	        {
+	            // Nothing regular to do: background work before spinning/parking
+	            // (skipped on shutdown, queued idle work is discarded)
+	            if (!m_stop_tasks.load(std::memory_order_relaxed) &&
+	                m_idle_pending.load(std::memory_order_relaxed) > 0 &&
+	                run_idle_task(std::numeric_limits<std::int64_t>::max(), true))
+	            {
+	                continue;
+	            }
+
+	            if (spin_for_task(spin_budget)) continue;
+
 	            std::unique_lock<std::mutex> lock(m_task_mutex);
+	            m_sleeping_workers.fetch_add(1);
 	            m_task_cv.wait(lock, [this]{
-	                return !m_tasks.empty() || m_stop_tasks;
+	                return m_pending_tasks.load() > 0 || m_idle_pending.load() > 0 || m_stop_tasks;
 	            });
-	            
-	            if (m_stop_tasks && m_tasks.empty()) 
+	            m_sleeping_workers.fetch_sub(1);
+
+	            if (m_stop_tasks && m_pending_tasks.load() == 0) 
 	            {
 	                return;
 	            }
-	            
-	            task = std::move(m_tasks.front());
-	            m_tasks.pop();
+	            continue;
 	        }
-	        
-	        try {
-	            task();
-	        } catch (const std::exception& e) {
-	            LOG_ERROR("Exception in task: {}", e.what());
+
+	        const std::int64_t start = now_ns();
+	        const bool completed = run_task(task);
+	        const std::int64_t end = now_ns();
+
+	        if (completed)
+	        {
+	            note_completed(lane, task.enqueue_ns, start);
 	        }
+
+	        bump(counters.idle_ns, static_cast<std::uint64_t>(std::max<std::int64_t>(0, start - idle_since)));
+	        bump(counters.busy_ns, static_cast<std::uint64_t>(std::max<std::int64_t>(0, end - start)));
+	        idle_since = end;
 	    }
 	}
 
@@ -3,6 +3,16 @@
 
 #include "core/utils/logger/logger.hpp"
 #include "core/utils/service_locator/service_locator.hpp"
+#include "core/utils/timer/periodic_runner.hpp"
+#include "work_stealing_queue.hpp"
+#include "task_function.hpp"
+#include "task_future.hpp"
+#include "completion_handle.hpp"
+#include "cancellation.hpp"
+#include "parallel_region.hpp"
+#include "thread_scheduling.hpp"
+#include "cpu_topology.hpp"
+#include "timer_wheel.hpp"
 
 #include <vector>
 #include <thread>
@@ -10,8 +20,14 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
-#include <queue>
 #include <future>
+#include <memory>
+#include <type_traits>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
 
 namespace RoboTact::Core
 {
@@ -21,9 +37,17 @@ namespace RoboTact::Core
  * @brief Real-time thread orchestration system
  * 
  * Key Features:
- * - Priority-based thread scheduling (MAIN > SIMULATION > IO)
- * - Work-stealing task queue
- * - Sub-millisecond task dispatch latency
+ * - Priority-based thread scheduling (MAIN > SIMULATION > IO), with one
+ *   task lane per ThreadType and starvation protection for lower lanes
+ * - Work-stealing task queue (one deque per worker), stealing from
+ *   workers on the same NUMA node first
+ * - Pool sized and pinned from the CPU topology (physical cores first,
+ *   cores reserved for the dedicated MAIN/SIMULATION/IO loops)
+ * - Sub-millisecond task dispatch latency (adaptive spin-then-park waiting)
+ * - Idle lane for background work, run in main-loop frame slack or by
+ *   workers that would otherwise park
+ * - Deterministic mode: every loop and task runs on the caller's thread
+ *   in a fixed order against a virtual clock, for reproducible runs
  * - Exception resilience policies
  * 
  * @invariant All public methods are thread-safe
@@ -42,7 +66,133 @@ public:
 		IO
 	};
 
+	/// Number of task priority lanes (one per ThreadType)
+	static constexpr std::size_t LANE_COUNT = 3;
+
+	/// Lane used by the enqueue overloads that do not name one
+	static constexpr ThreadType DEFAULT_LANE = ThreadType::SIMULATION;
+
+	/// Every Nth dispatch of a worker serves the lowest non-empty lane first
+	static constexpr std::uint32_t STARVATION_INTERVAL = 16;
+
+	/// Smallest automatically sized pool; core reservation never goes below it
+	static constexpr std::size_t MIN_WORKERS = 2;
+
+	/**
+	 * @struct TaskOptions
+	 * @brief Lane, cancellation token and deadline of an enqueued task
+	 *
+	 * A task whose token is cancelled, or whose deadline has passed, by
+	 * the time a worker dequeues it is dropped without running; its
+	 * future fails with TaskCancelled.
+	 */
+	struct TaskOptions
+	{
+		ThreadType lane 					{DEFAULT_LANE};
+		CancellationToken token;
+		std::chrono::steady_clock::time_point deadline {std::chrono::steady_clock::time_point::max()};
+	};
+
+	/// Buckets of the enqueue-to-start histogram; bucket k counts waits in
+	/// [2^(k-1), 2^k) ns, bucket 0 zero waits, the last one everything longer
+	static constexpr std::size_t LATENCY_BUCKETS = 32;
+
+	/**
+	 * @struct LaneStats
+	 * @brief Snapshot of one task lane's counters
+	 */
+	struct LaneStats
+	{
+		std::size_t queue_depth 		{0};	///< Tasks currently queued
+		std::size_t depth_high_water 	{0};	///< Deepest queue since last reset
+		std::uint64_t enqueued 			{0};	///< Tasks pushed since last reset
+		std::uint64_t dequeued 			{0};	///< Tasks run since last reset (cancelled ones excluded)
+		std::uint64_t cancelled 		{0};	///< Tasks dropped by token/deadline
+		double average_wait_ms 			{0.0};	///< Mean enqueue-to-start time
+		double max_wait_ms 				{0.0};	///< Worst enqueue-to-start time
+		std::array<std::uint64_t, LATENCY_BUCKETS> wait_histogram {};
+
+		/**
+		 * @brief Upper bound of the p-quantile wait (p in [0, 1]) from the histogram
+		 */
+		[[nodiscard]] double wait_percentile_ms(double p) const noexcept;
+	};
+
+	/**
+	 * @struct WorkerStats
+	 * @brief Snapshot of one pool worker's counters
+	 */
+	struct WorkerStats
+	{
+		int node 						{0};	///< NUMA node the worker runs on
+		std::uint64_t tasks_executed 	{0};
+		std::uint64_t steals 			{0};	///< Tasks taken from other workers' deques
+		double busy_ms 					{0.0};	///< Time spent running tasks
+		double idle_ms 					{0.0};	///< Time spent looking for / waiting on work
+
+		[[nodiscard]] double utilization() const noexcept
+		{
+			const double total = busy_ms + idle_ms;
+			return total > 0.0 ? busy_ms / total : 0.0;
+		}
+	};
+
+	/**
+	 * @struct SchedulerStats
+	 * @brief Snapshot of the whole pool, e.g. for an ImGui overlay
+	 */
+	struct SchedulerStats
+	{
+		std::vector<WorkerStats> workers;
+		std::array<LaneStats, LANE_COUNT> lanes;
+		std::size_t pending_tasks 		{0};
+		std::size_t idle_pending 		{0};	///< Queued idle-lane tasks
+		std::uint64_t idle_executed 	{0};	///< Idle-lane slices run since last reset
+	};
+
+	/**
+	 * @struct WaitStrategy
+	 * @brief How an idle worker waits for new tasks before parking
+	 *
+	 * An idle worker first spins with a CPU pause hint, then yields its
+	 * time slice a few times, and only then blocks on the condition
+	 * variable. With `adaptive`, each worker's spin budget doubles when
+	 * spinning caught a task and halves when it ended up parking, so
+	 * bursty loads get sub-microsecond wake-ups while an idle pool
+	 * quickly stops burning CPU.
+	 */
+	struct WaitStrategy
+	{
+		std::uint32_t max_spin 			{4096};	///< Upper bound of pause iterations per wait
+		std::uint32_t yield_count 		{8};	///< Yields after spinning, before parking
+		bool adaptive 					{true};	///< false = always spin max_spin times
+	};
+
+	/**
+	 * @enum ExecutionMode
+	 * @brief How threads and tasks are executed
+	 */
+	enum class ExecutionMode
+	{
+		PARALLEL,		///< Real threads and a worker pool (default)
+		DETERMINISTIC	///< Single thread, fixed order, virtual clock (see step_deterministic())
+	};
+
+	/**
+	 * @struct PoolConfig
+	 * @brief Sizing and placement of the task worker pool
+	 */
+	struct PoolConfig
+	{
+		ExecutionMode mode 				{ExecutionMode::PARALLEL};
+		std::size_t worker_count 		{0};		///< 0 = one per free physical core (at least MIN_WORKERS)
+		std::size_t reserved_cores 		{2};		///< Physical cores kept for the pinned SIMULATION/IO loops
+		bool use_smt_siblings 			{false};	///< Also place workers on SMT siblings
+		bool pin_workers 				{true};		///< Pin each worker to its CPU
+	};
+
 	ThreadManager();
+	explicit ThreadManager(PoolConfig config);
 	~ThreadManager();
 
 	// Non-copyable (threads are movable-only)
@@ -58,8 +208,56 @@ public:
      */
 	void start_thread(ThreadType type, std::function<void()> func);
 
+	/**
+     * @brief Starts a managed thread that runs `tick` at a fixed rate
+     * @param type Thread priority classification
+     * @param config Period, spin window and overrun policy
+     * @param tick Work for one period (must return, not loop)
+     * 
+     * Uses absolute deadlines, so the rate does not drift with the work
+     * duration. Timing statistics are available via get_periodic_stats().
+     */
+	void start_periodic_thread(ThreadType type, PeriodicConfig config, std::function<void()> tick);
+
+	/**
+     * @brief Advances a DETERMINISTIC manager by `frame` of virtual time
+     * 
+     * Runs, on the calling thread and in a fixed order:
+     * - queued tasks, FIFO within a lane and lanes in priority order
+     *   (not global submission order),
+     * - every periodic loop whose virtual deadline falls inside the
+     *   frame (earliest deadline first, ties in registration order),
+     *   draining the task queue after each tick,
+     * - one iteration of each plain start_thread() loop.
+     * 
+     * The same sequence of calls therefore always produces the same
+     * execution order. No-op in PARALLEL mode.
+     */
+	void step_deterministic(std::chrono::nanoseconds frame);
+
+	[[nodiscard]] ExecutionMode execution_mode() const noexcept { return m_mode; }
+	[[nodiscard]] bool is_deterministic() const noexcept { return m_mode == ExecutionMode::DETERMINISTIC; }
+
+	/**
+     * @brief Current time as seen by tasks and deadlines
+     * 
+     * steady_clock::now() in PARALLEL mode; the virtual clock (advanced
+     * only by step_deterministic()) in DETERMINISTIC mode. Use it to
+     * build TaskOptions deadlines.
+     */
+	[[nodiscard]] std::chrono::steady_clock::time_point now() const noexcept;
+
+	/**
+     * @brief Jitter/overrun statistics of the periodic thread of a type
+     * @return Empty stats if no periodic thread of that type was started
+     */
+	[[nodiscard]] PeriodicStats get_periodic_stats(ThreadType type);
+
 	/**
      * @brief Graceful shutdown (joins all threads)
+     *
+     * Workers drain the queues before exiting; tasks still queued after
+     * the join (emergency stop, late pushes) are destroyed unrun.
      * @timeout_ms Max wait time (0=indefinite)
      * @return true if all threads stopped cleanly
      */
@@ -81,6 +279,63 @@ public:
      */
 	bool should_continue() const noexcept;
 
+	/**
+     * @brief Sets CPU pinning / real-time policy for threads of a type
+     * @param type Thread classification the config applies to
+     * @param config Requested placement and priority
+     * 
+     * Applied to running threads of that type and to every thread
+     * started later with start_thread(). Missing privileges are logged
+     * as warnings and the thread keeps default scheduling.
+     */
+	void configure_thread_type(ThreadType type, ThreadSchedulingConfig config);
+
+	/**
+     * @brief Sets CPU pinning / real-time policy for the task workers
+     * 
+     * Workers are created in the constructor; this re-places them in
+     * place. With `config.spread`, worker i is pinned to cpus[i % n].
+     */
+	void configure_workers(ThreadSchedulingConfig config);
+
+	/**
+     * @brief Sets how idle workers wait before blocking
+     * 
+     * Takes effect at each worker's next wait. Use max_spin = 0 and
+     * yield_count = 0 for pure blocking (lowest CPU use).
+     */
+	void set_wait_strategy(WaitStrategy strategy) noexcept;
+
+	/**
+     * @brief Currently active WaitStrategy
+     */
+	[[nodiscard]] WaitStrategy get_wait_strategy() const noexcept;
+
+	/**
+     * @brief CPU layout the pool was sized and placed from
+     */
+	[[nodiscard]] const CpuTopology& topology() const noexcept { return m_topology; }
+
+	/**
+     * @brief CPUs of the cores kept free of workers (one per core)
+     * 
+     * Intended for configure_thread_type(), e.g. pinning SIMULATION to
+     * reserved_cpus()[0] and IO to reserved_cpus()[1]. Holds fewer than
+     * reserved_cores entries when only MIN_WORKERS cores would be left.
+     */
+	[[nodiscard]] const std::vector<int>& reserved_cpus() const noexcept { return m_reserved_cpus; }
+
+	/**
+     * @brief NUMA node a worker was placed on (0 if unpinned)
+     */
+	[[nodiscard]] int worker_node(std::size_t worker) const noexcept;
+
+	/**
+     * @brief Locks the process memory (mlockall) to avoid page-fault stalls
+     * @return true on success
+     */
+	bool lock_memory();
+
 	/**
      * @brief Enqueues a task with perfect forwarding
      * @tparam F Callable type
@@ -93,7 +348,244 @@ public:
      */
 	template<typename F, typename... Args>
 	auto enqueue_task(F&& f, Args&&... args)
-		-> std::future<typename std::invoke_result<F(Args...)>::type>;
+		-> std::future<std::invoke_result_t<F, Args...>>;
+
+	/**
+     * @brief Enqueues a task on a specific priority lane
+     * @param lane Priority lane (MAIN > SIMULATION > IO)
+     */
+	template<typename F, typename... Args>
+	auto enqueue_task(ThreadType lane, F&& f, Args&&... args)
+		-> std::future<std::invoke_result_t<F, Args...>>;
+
+	/**
+     * @brief Enqueues a cancellable task with an optional deadline
+     * @param options Lane, cancellation token and deadline
+     * 
+     * The future fails with TaskCancelled if the task is dropped.
+     */
+	template<typename F, typename... Args>
+	auto enqueue_task(TaskOptions options, F&& f, Args&&... args)
+		-> std::future<std::invoke_result_t<F, Args...>>;
+
+	/**
+     * @brief Enqueues a task and returns a lightweight TaskFuture
+     * 
+     * The callable, its arguments and the result share a single
+     * allocation; nothing else on the dispatch path allocates.
+     * 
+     * @return TaskFuture containing task result
+     */
+	template<typename F, typename... Args>
+	auto submit(F&& f, Args&&... args)
+		-> TaskFuture<std::invoke_result_t<F, Args...>>;
+
+	/**
+     * @brief submit() on a specific priority lane
+     */
+	template<typename F, typename... Args>
+	auto submit(ThreadType lane, F&& f, Args&&... args)
+		-> TaskFuture<std::invoke_result_t<F, Args...>>;
+
+	/**
+     * @brief submit() with cancellation token and deadline
+     * 
+     * The future fails with TaskCancelled if the task is dropped.
+     */
+	template<typename F, typename... Args>
+	auto submit(TaskOptions options, F&& f, Args&&... args)
+		-> TaskFuture<std::invoke_result_t<F, Args...>>;
+
+	/**
+     * @brief Fire-and-forget enqueue without any result channel
+     * 
+     * Allocation-free when the callable fits in TaskFunction::INLINE_SIZE.
+     * Exceptions escaping the callable are logged by the worker.
+     */
+	template<typename F>
+	void post(F&& f);
+
+	/**
+     * @brief post() on a specific priority lane
+     */
+	template<typename F>
+	void post(ThreadType lane, F&& f);
+
+	/**
+     * @brief post() with cancellation token and deadline (dropped silently)
+     */
+	template<typename F>
+	void post(TaskOptions options, F&& f);
+
+	/**
+     * @brief post() that refuses work once stop_all() has begun
+     * @return False if `f` was not queued (it will never run)
+     * 
+     * Used where dropped work would leave something waiting forever,
+     * e.g. coroutine resumptions.
+     */
+	template<typename F>
+	bool try_post(ThreadType lane, F&& f);
+
+	/**
+     * @brief Enqueues `count` tasks running body(i), i in [0, count)
+     * @param body Callable invoked as body(std::size_t), shared by all tasks
+     * @return One handle completing when every task has finished
+     * 
+     * The batch is split across the worker deques with one lock per
+     * deque, and at most min(count, sleeping) parked workers are woken
+     * with a single notification step. Per-task storage is two words,
+     * so no allocation happens beyond the shared body.
+     *
+     * Once stop_all() has begun the batch is refused; tasks refused or
+     * dropped by the pool complete the handle with TaskCancelled.
+     */
+	template<typename F>
+	CompletionHandle enqueue_bulk(std::size_t count, F&& body);
+
+	/**
+     * @brief enqueue_bulk() on a specific priority lane
+     */
+	template<typename F>
+	CompletionHandle enqueue_bulk(ThreadType lane, std::size_t count, F&& body);
+
+	/**
+     * @brief Enqueues one task per element of [first, last), running body(*it)
+     * 
+     * Elements are accessed from worker threads, so the range must stay
+     * valid until the returned handle is done.
+     */
+	template<typename It, typename F>
+	CompletionHandle enqueue_range(It first, It last, F&& body);
+
+	/**
+     * @brief enqueue_range() on a specific priority lane
+     */
+	template<typename It, typename F>
+	CompletionHandle enqueue_range(ThreadType lane, It first, It last, F&& body);
+
+	/**
+     * @brief Queues low-priority background work on the idle lane
+     * @param f Callable; if it returns bool, `true` means "not finished,
+     *          run me again later" (the slice is re-queued at the back)
+     * 
+     * Idle tasks never run ahead of regular tasks: they are picked up in
+     * the main loop's frame slack (run_idle_tasks()) or by workers that
+     * found nothing else to do. Long work should be split into slices
+     * that return early once should_yield() is true. Idle tasks still
+     * queued at stop_all() are discarded.
+     */
+	template<typename F>
+	void post_idle(F&& f);
+
+	/**
+     * @brief Runs idle-lane tasks on the calling thread for up to `budget`
+     * @return Number of idle slices executed
+     * 
+     * Called by the main loop with the time left before the frame ends.
+     */
+	std::size_t run_idle_tasks(std::chrono::nanoseconds budget);
+
+	/**
+     * @brief Polled by idle-lane tasks: true once they should return
+     * 
+     * Becomes true when the frame-slack budget is used up, once
+     * stop_all() has been called, or (on pool workers) as soon as
+     * regular work is waiting. Always false outside an idle-lane task.
+     */
+	static bool should_yield() noexcept;
+
+	/**
+     * @brief Runs body(i) for every i in [begin, end) on the worker pool
+     * @param body Callable invoked as body(std::size_t)
+     * @param grain Indices per chunk (0 = choose from pool size)
+     * 
+     * The calling thread claims chunks as well and, once none are left,
+     * helps with other queued tasks until every chunk has finished.
+     * 
+     * @throws The first exception thrown by body (remaining chunks are skipped)
+     */
+	template<typename F>
+	void parallel_for(std::size_t begin, std::size_t end, F&& body, std::size_t grain = 0);
+
+	/**
+     * @brief Chunked map-reduce over [begin, end)
+     * @param identity Neutral element of reduce
+     * @param map Callable invoked as map(std::size_t) -> T
+     * @param reduce Associative callable reduce(T, T) -> T
+     * @param grain Indices per chunk (0 = choose from pool size)
+     * @return Reduction of all mapped values
+     * 
+     * Per-chunk partials are combined in index order, so the result is
+     * deterministic for a given grain even for floating-point sums.
+     */
+	template<typename T, typename Map, typename Reduce>
+	T parallel_reduce(std::size_t begin, std::size_t end, T identity,
+					  Map&& map, Reduce&& reduce, std::size_t grain = 0);
+
+	/**
+     * @brief Runs all callables concurrently and returns when all are done
+     */
+	template<typename... Fs>
+	void parallel_invoke(Fs&&... fs);
+
+	/**
+     * @brief Runs one queued task on the calling thread, if any
+     * @return true if a task was executed
+     * 
+     * Lets threads that wait on pool work help instead of blocking.
+     */
+	bool try_run_pending_task();
+
+	/**
+     * @brief Number of task workers in the pool
+     */
+	[[nodiscard]] std::size_t worker_count() const noexcept;
+
+	/**
+     * @brief Timer wheel used for timed task/coroutine resumption
+     * 
+     * Its thread starts on first use and is stopped by stop_all().
+     */
+	[[nodiscard]] TimerWheel& timer_wheel() noexcept { return m_timer_wheel; }
+
+	/**
+     * @brief Queue depth and wait-time counters of one lane
+     * 
+     * @lockfree Counters are relaxed atomics; values may be slightly stale
+     */
+	[[nodiscard]] LaneStats get_lane_stats(ThreadType lane) const noexcept;
+
+	/**
+     * @brief Resets the cumulative lane counters (queue depth is kept)
+     */
+	void reset_lane_stats() noexcept;
+
+	/**
+     * @brief Per-worker and per-lane counters of the pool
+     * 
+     * @lockfree Counters are relaxed atomics updated only by their owner
+     *           thread; values may be slightly stale and not mutually
+     *           consistent
+     */
+	[[nodiscard]] SchedulerStats get_stats() const;
+
+	/**
+     * @brief Resets lane and worker counters
+     */
+	void reset_stats() noexcept;
+
+	/**
+     * @brief Writes a summary of get_stats() to the log at DEBUG level
+     *        (kept out of an INFO console, still in file/ring sinks)
+     */
+	void log_stats() const;
+
+	/**
+     * @brief log_stats() at most once per interval (cheap to call every tick)
+     * @return true if the stats were logged
+     */
+	bool log_stats_if_due(std::chrono::milliseconds interval);
 
 private:
 	struct ThreadInfo
@@ -101,9 +593,10 @@ private:
 		ThreadType type;
 		std::thread thread;
 		std::atomic<bool> running;
+		bool is_worker;
 
-		ThreadInfo(ThreadType t, std::thread&& thr, bool run)
-        : type(t), thread(std::move(thr)), running(run) {}
+		ThreadInfo(ThreadType t, std::thread&& thr, bool run, bool worker = false)
+        : type(t), thread(std::move(thr)), running(run), is_worker(worker) {}
 
         // Delete copy constructor and assignment (because std::thread is non-copyable)
 	    ThreadInfo(const ThreadInfo&) = delete;
@@ -111,7 +604,8 @@ private:
 
 	    // Define move constructor
 	    ThreadInfo(ThreadInfo&& other) noexcept
-	        : type(other.type), thread(std::move(other.thread)), running(other.running.load()) {}
+	        : type(other.type), thread(std::move(other.thread)), running(other.running.load()),
+	          is_worker(other.is_worker) {}
 
 	    // Define move assignment operator
 	    ThreadInfo& operator=(ThreadInfo&& other) noexcept {
@@ -119,51 +613,548 @@ private:
 	            type = other.type;
 	            thread = std::move(other.thread);
 	            running.store(other.running.load());
+	            is_worker = other.is_worker;
 	        }
 	        return *this;
 	    }
 	};
 
 	std::vector<ThreadInfo> m_threads;
+	std::mutex m_threads_mutex;
+
+	std::array<ThreadSchedulingConfig, LANE_COUNT> m_scheduling;
+	std::array<std::shared_ptr<PeriodicRunner>, LANE_COUNT> m_periodic_runners;
+	ThreadSchedulingConfig m_worker_scheduling;
 	std::atomic<bool> m_running					{false};
 	std::atomic<bool> m_emergency_stop			{false};
 
 	// Task queue members
+	struct QueuedTask
+	{
+		TaskFunction work;
+		std::int64_t enqueue_ns 				{0};
+	};
+
+	using TaskQueue = WorkStealingQueue<QueuedTask>;
+
+	// Wait statistics of the tasks one thread took from a lane
+	struct LaneWaitCounters
+	{
+		std::atomic<std::size_t> high_water 	{0};	///< Deepest lane depth seen at dequeue
+		std::atomic<std::uint64_t> dequeued 	{0};	///< Tasks run to completion (not cancelled)
+		std::atomic<std::uint64_t> wait_ns 		{0};
+		std::atomic<std::uint64_t> max_wait_ns 	{0};
+		std::array<std::atomic<std::uint64_t>, LATENCY_BUCKETS> wait_histogram {};
+	};
+
+	// Written only by the owning worker, read by get_stats()
+	struct alignas(64) WorkerCounters
+	{
+		std::atomic<std::uint64_t> tasks_executed 	{0};
+		std::atomic<std::uint64_t> steals 			{0};
+		std::atomic<std::uint64_t> busy_ns 			{0};
+		std::atomic<std::uint64_t> idle_ns 			{0};
+		std::array<LaneWaitCounters, LANE_COUNT> lanes;
+	};
+
+	struct WorkerQueues
+	{
+		std::array<TaskQueue, LANE_COUNT> lanes;
+		WorkerCounters counters;
+	};
+
+	struct alignas(64) LaneCounters
+	{
+		std::atomic<std::size_t> depth 			{0};
+		std::atomic<std::uint64_t> enqueued 	{0};
+		std::atomic<std::uint64_t> cancelled 	{0};
+	};
+
+	// Pool placement
+	CpuTopology m_topology;
+	std::vector<int> m_reserved_cpus;
+	std::vector<int> m_worker_nodes;
+	std::vector<std::vector<std::size_t>> m_steal_order;	///< Victims per worker, local node first
+
+	// DETERMINISTIC mode: loops registered instead of started as threads
+	struct DeterministicLoop
+	{
+		ThreadType type;
+		std::function<void()> body;
+		std::chrono::nanoseconds period 		{0};	///< 0 = plain loop, once per step
+		std::chrono::nanoseconds next_deadline 	{0};	///< Virtual time of the next tick
+		PeriodicStats stats;
+	};
+
+	ExecutionMode m_mode 						{ExecutionMode::PARALLEL};
+	std::vector<std::unique_ptr<DeterministicLoop>> m_deterministic_loops;	// Stable across registration
+	std::atomic<std::int64_t> m_virtual_time_ns {0};
+	std::chrono::steady_clock::time_point m_virtual_origin;
+
+	std::vector<std::unique_ptr<WorkerQueues>> m_queues;
+	std::array<LaneCounters, LANE_COUNT> m_lanes;
+	WorkerCounters m_external_counters;			///< Tasks run by non-worker threads (shared, RMW updates)
+	std::atomic<std::size_t> m_next_queue		{0};
+	std::atomic<std::size_t> m_pending_tasks	{0};
+	std::atomic<std::size_t> m_sleeping_workers	{0};
+	std::atomic<std::int64_t> m_last_stats_log_ns	{0};
+
+	// Idle lane: one shared FIFO, served only when nothing else is queued
+	TaskQueue m_idle_queue;
+	std::atomic<std::size_t> m_idle_pending 		{0};
+	std::atomic<std::uint64_t> m_idle_executed 		{0};
+
+	// WaitStrategy fields, read by workers on every idle wait
+	std::atomic<std::uint32_t> m_max_spin		{WaitStrategy{}.max_spin};
+	std::atomic<std::uint32_t> m_yield_count	{WaitStrategy{}.yield_count};
+	std::atomic<bool> m_adaptive_spin			{WaitStrategy{}.adaptive};
+
+	TimerWheel m_timer_wheel;
+
+	// Parking lot for idle workers
 	std::mutex m_task_mutex;
 	std::condition_variable m_task_cv;
-	std::queue<std::function<void()>> m_tasks;
-	bool m_stop_tasks 							{false};
+	std::atomic<bool> m_stop_tasks 				{false};
+
+	void worker_loop(std::size_t index);
+	std::vector<int> plan_workers(const PoolConfig& config);
+	void build_steal_order();
+	void push_task(ThreadType lane, TaskFunction&& work);
+	bool try_push_task(ThreadType lane, TaskFunction&& work);
+	void enqueue_task(ThreadType lane, TaskFunction&& work);
+	bool try_acquire_task(std::size_t index, QueuedTask& task, std::size_t& lane);
+	bool try_acquire_from_lane(std::size_t index, std::size_t lane, QueuedTask& task);
+	void discard_queued_tasks();
+	void wake_workers(std::size_t count);
+	bool begin_bulk_push(ThreadType lane, std::size_t count, std::size_t& first_queue);
+	void finish_bulk_push(ThreadType lane, std::size_t count, std::size_t pushed);
+	bool spin_for_task(std::uint32_t& spin_budget);
+	bool run_task(QueuedTask& task);
+	void note_dequeued(std::size_t lane, std::size_t depth) noexcept;
+	void note_completed(std::size_t lane, std::int64_t enqueue_ns, std::int64_t start_ns) noexcept;
+	void note_cancelled(ThreadType lane) noexcept;
+	void push_idle_task(TaskFunction&& work);
+	bool run_idle_task(std::int64_t deadline_ns, bool yield_on_pending);
+	void register_deterministic_loop(ThreadType type, std::function<void()> body,
+									 std::chrono::nanoseconds period);
+	bool run_deterministic_body(DeterministicLoop& loop);
+	void drain_deterministic_tasks();
+
+	/**
+	 * @brief Re-queues a bool-returning idle task until it reports done
+	 */
+	template<typename Fn>
+	struct IdleSlice
+	{
+		ThreadManager* owner;
+		Fn fn;
+
+		void operator()()
+		{
+			// Not re-queued once stopping, so workers can drain and exit
+			if (fn() && !owner->m_stop_tasks.load(std::memory_order_relaxed))
+			{
+				owner->push_idle_task(TaskFunction(std::move(*this)));
+			}
+		}
+	};
+
+	static std::int64_t now_ns() noexcept;
+	static const char* thread_type_name(ThreadType type) noexcept;
 
-	void worker_loop();
+	std::size_t auto_grain(std::size_t count) const noexcept;
+
+	template<typename Make>
+	void push_task_bulk(ThreadType lane, std::size_t count, Make&& make);
+
+	template<typename ChunkFn>
+	void run_parallel_region(std::size_t chunk_count, ChunkFn& chunk);
 };
 
 	// Template implementations 
 	template<typename F, typename... Args>
 	auto ThreadManager::enqueue_task(F&& f, Args&&... args)
-		-> std::future<typename std::invoke_result<F(Args...)>::type>
+		-> std::future<std::invoke_result_t<F, Args...>>
+	{
+		return enqueue_task(DEFAULT_LANE, std::forward<F>(f), std::forward<Args>(args)...);
+	}
+
+	template<typename F, typename... Args>
+	auto ThreadManager::enqueue_task(ThreadType lane, F&& f, Args&&... args)
+		-> std::future<std::invoke_result_t<F, Args...>>
+	{
+		using return_type = std::invoke_result_t<F, Args...>;
+
+		std::promise<return_type> promise;
+		std::future<return_type> res = promise.get_future();
+
+		push_task(lane, [promise = std::move(promise),
+				   fn = std::forward<F>(f),
+				   ...bound = std::forward<Args>(args)]() mutable
+		{
+			try
+			{
+				if constexpr (std::is_void_v<return_type>)
+				{
+					std::invoke(fn, bound...);
+					promise.set_value();
+				}
+				else
+				{
+					promise.set_value(std::invoke(fn, bound...));
+				}
+			}
+			catch (...)
+			{
+				promise.set_exception(std::current_exception());
+			}
+		});
+		return res;
+	}
+
+	template<typename F, typename... Args>
+	auto ThreadManager::enqueue_task(TaskOptions options, F&& f, Args&&... args)
+		-> std::future<std::invoke_result_t<F, Args...>>
 	{
-		using return_type = typename std::invoke_result<F(Args...)>::type;
+		using return_type = std::invoke_result_t<F, Args...>;
 
-		auto task = std::make_shared<std::packaged_task<return_type()>>(
-			std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-		);
+		std::promise<return_type> promise;
+		std::future<return_type> res = promise.get_future();
 
-		std::future<return_type> res = task->get_future();
+		push_task(options.lane, [this, lane = options.lane,
+				   guard = detail::TaskGuard{ std::move(options.token), options.deadline },
+				   promise = std::move(promise),
+				   fn = std::forward<F>(f),
+				   ...bound = std::forward<Args>(args)]() mutable
 		{
-			std::unique_lock<std::mutex> lock(m_task_mutex);
+			if (const char* reason = guard.expired([this] { return now(); }))
+			{
+				note_cancelled(lane);
+				promise.set_exception(std::make_exception_ptr(TaskCancelled(reason)));
+				return;
+			}
 
-			if (m_stop_tasks)
+			try
+			{
+				if constexpr (std::is_void_v<return_type>)
+				{
+					std::invoke(fn, bound...);
+					promise.set_value();
+				}
+				else
+				{
+					promise.set_value(std::invoke(fn, bound...));
+				}
+			}
+			catch (...)
 			{
-				LOG_ERROR("enqueue on stopped ThreadManager");
+				promise.set_exception(std::current_exception());
 			}
+		});
+		return res;
+	}
 
-			m_tasks.emplace([task](){ (*task)(); });
-		}
+	template<typename F, typename... Args>
+	auto ThreadManager::submit(F&& f, Args&&... args)
+		-> TaskFuture<std::invoke_result_t<F, Args...>>
+	{
+		return submit(DEFAULT_LANE, std::forward<F>(f), std::forward<Args>(args)...);
+	}
+
+	template<typename F, typename... Args>
+	auto ThreadManager::submit(ThreadType lane, F&& f, Args&&... args)
+		-> TaskFuture<std::invoke_result_t<F, Args...>>
+	{
+		using return_type = std::invoke_result_t<F, Args...>;
+
+		auto bound = [fn = std::forward<F>(f),
+					  ...bound = std::forward<Args>(args)]() mutable -> return_type
+		{
+			return std::invoke(fn, bound...);
+		};
+
+		using State = detail::PackagedTaskState<return_type, decltype(bound)>;
+		auto* state = new State(std::move(bound));
+
+		state->add_ref();
+		TaskFuture<return_type> res(state);
+		push_task(lane, detail::PackagedTaskRunner<return_type, decltype(bound)>(state));
+		return res;
+	}
+
+	template<typename F, typename... Args>
+	auto ThreadManager::submit(TaskOptions options, F&& f, Args&&... args)
+		-> TaskFuture<std::invoke_result_t<F, Args...>>
+	{
+		using return_type = std::invoke_result_t<F, Args...>;
+
+		auto bound = [fn = std::forward<F>(f),
+					  ...bound = std::forward<Args>(args)]() mutable -> return_type
+		{
+			return std::invoke(fn, bound...);
+		};
 
-		m_task_cv.notify_one();
+		using State = detail::PackagedTaskState<return_type, decltype(bound)>;
+		using Runner = detail::PackagedTaskRunner<return_type, decltype(bound)>;
+		auto* state = new State(std::move(bound));
+
+		state->add_ref();
+		TaskFuture<return_type> res(state);
+		push_task(options.lane, [this, lane = options.lane,
+				   guard = detail::TaskGuard{ std::move(options.token), options.deadline },
+				   runner = Runner(state)]() mutable
+		{
+			if (const char* reason = guard.expired([this] { return now(); }))
+			{
+				note_cancelled(lane);
+				runner.cancel(std::make_exception_ptr(TaskCancelled(reason)));
+				return;
+			}
+			runner();
+		});
 		return res;
 	}
 
+	template<typename F>
+	void ThreadManager::post(F&& f)
+	{
+		post(DEFAULT_LANE, std::forward<F>(f));
+	}
+
+	template<typename F>
+	void ThreadManager::post(ThreadType lane, F&& f)
+	{
+		push_task(lane, TaskFunction(std::forward<F>(f)));
+	}
+
+	template<typename F>
+	bool ThreadManager::try_post(ThreadType lane, F&& f)
+	{
+		return try_push_task(lane, TaskFunction(std::forward<F>(f)));
+	}
+
+	template<typename F>
+	void ThreadManager::post(TaskOptions options, F&& f)
+	{
+		push_task(options.lane, [this, lane = options.lane,
+				   guard = detail::TaskGuard{ std::move(options.token), options.deadline },
+				   fn = std::forward<F>(f)]() mutable
+		{
+			if (guard.expired([this] { return now(); }))
+			{
+				note_cancelled(lane);
+				return;
+			}
+			fn();
+		});
+	}
+
+	template<typename F>
+	void ThreadManager::post_idle(F&& f)
+	{
+		using Fn = std::decay_t<F>;
+
+		if constexpr (std::is_same_v<std::invoke_result_t<Fn&>, bool>)
+		{
+			push_idle_task(TaskFunction(IdleSlice<Fn>{ this, std::forward<F>(f) }));
+		}
+		else
+		{
+			push_idle_task(TaskFunction(std::forward<F>(f)));
+		}
+	}
+
+	template<typename Make>
+	void ThreadManager::push_task_bulk(ThreadType lane, std::size_t count, Make&& make)
+	{
+		if (count == 0) return;
+
+		std::size_t first_queue = 0;
+		if (!begin_bulk_push(lane, count, first_queue))
+		{
+			// Refused while stopping: the tasks are destroyed unrun, which
+			// settles whatever tracks them
+			for (std::size_t i = 0; i < count; ++i) (void)make();
+			return;
+		}
+
+		const std::size_t queue_count = m_queues.size();
+		const std::size_t targets = std::min(count, queue_count);
+		const std::int64_t enqueue_ns = now_ns();
+
+		// Contiguous slices, one deque lock each
+		std::size_t pushed = 0;
+		try {
+			for (std::size_t t = 0; t < targets; ++t)
+			{
+				const std::size_t slice = count / targets + (t < count % targets ? 1 : 0);
+				TaskQueue& queue = m_queues[(first_queue + t) % queue_count]->lanes[static_cast<std::size_t>(lane)];
+				queue.push_bulk(slice, [&](std::size_t) {
+					QueuedTask task{ TaskFunction(make()), enqueue_ns };
+					++pushed;
+					return task;
+				});
+			}
+		} catch (...) {
+			finish_bulk_push(lane, count, pushed);
+			throw;
+		}
+
+		finish_bulk_push(lane, count, count);
+	}
+
+	template<typename F>
+	CompletionHandle ThreadManager::enqueue_bulk(std::size_t count, F&& body)
+	{
+		return enqueue_bulk(DEFAULT_LANE, count, std::forward<F>(body));
+	}
+
+	template<typename F>
+	CompletionHandle ThreadManager::enqueue_bulk(ThreadType lane, std::size_t count, F&& body)
+	{
+		using State = detail::BulkState<std::decay_t<F>>;
+		auto* state = new State(count, std::forward<F>(body));
+
+		std::size_t index = 0;
+		push_task_bulk(lane, count, [state, &index]() {
+			return detail::BulkTask<State, std::size_t>(state, index++);
+		});
+		return CompletionHandle(state);
+	}
+
+	template<typename It, typename F>
+	CompletionHandle ThreadManager::enqueue_range(It first, It last, F&& body)
+	{
+		return enqueue_range(DEFAULT_LANE, first, last, std::forward<F>(body));
+	}
+
+	template<typename It, typename F>
+	CompletionHandle ThreadManager::enqueue_range(ThreadType lane, It first, It last, F&& body)
+	{
+		using State = detail::BulkState<detail::DereferenceBody<std::decay_t<F>>>;
+		const auto count = static_cast<std::size_t>(std::distance(first, last));
+		auto* state = new State(count, detail::DereferenceBody<std::decay_t<F>>{ std::forward<F>(body) });
+
+		push_task_bulk(lane, count, [state, &first]() {
+			return detail::BulkTask<State, It>(state, first++);
+		});
+		return CompletionHandle(state);
+	}
+
+	template<typename ChunkFn>
+	void ThreadManager::run_parallel_region(std::size_t chunk_count, ChunkFn& chunk)
+	{
+		auto region = std::make_shared<detail::ParallelRegion>(chunk_count);
+
+		// One helper per worker at most; the caller is the extra participant
+		const std::size_t helpers = std::min(worker_count(), chunk_count - 1);
+		for (std::size_t i = 0; i < helpers; ++i)
+		{
+			post([region, &chunk]() { region->run(chunk); });
+		}
+
+		region->run(chunk);
+
+		std::size_t done;
+		while ((done = region->done_chunks()) < chunk_count)
+		{
+			if (!try_run_pending_task())
+			{
+				region->wait_for_progress(done);
+			}
+		}
+
+		region->rethrow_if_failed();
+	}
+
+	template<typename F>
+	void ThreadManager::parallel_for(std::size_t begin, std::size_t end, F&& body, std::size_t grain)
+	{
+		if (begin >= end) return;
+
+		const std::size_t count = end - begin;
+		if (grain == 0) grain = auto_grain(count);
+
+		const std::size_t chunk_count = (count + grain - 1) / grain;
+		auto chunk = [&](std::size_t index)
+		{
+			const std::size_t first = begin + index * grain;
+			const std::size_t last = std::min(first + grain, end);
+			for (std::size_t i = first; i < last; ++i)
+			{
+				body(i);
+			}
+		};
+
+		if (chunk_count == 1)
+		{
+			chunk(0);
+			return;
+		}
+		run_parallel_region(chunk_count, chunk);
+	}
+
+	template<typename T, typename Map, typename Reduce>
+	T ThreadManager::parallel_reduce(std::size_t begin, std::size_t end, T identity,
+									 Map&& map, Reduce&& reduce, std::size_t grain)
+	{
+		if (begin >= end) return identity;
+
+		const std::size_t count = end - begin;
+		if (grain == 0) grain = auto_grain(count);
+
+		const std::size_t chunk_count = (count + grain - 1) / grain;
+		std::vector<T> partials(chunk_count, identity);
+
+		auto chunk = [&](std::size_t index)
+		{
+			const std::size_t first = begin + index * grain;
+			const std::size_t last = std::min(first + grain, end);
+
+			T acc = identity;
+			for (std::size_t i = first; i < last; ++i)
+			{
+				acc = reduce(std::move(acc), map(i));
+			}
+			partials[index] = std::move(acc);
+		};
+
+		if (chunk_count == 1)
+		{
+			chunk(0);
+		}
+		else
+		{
+			run_parallel_region(chunk_count, chunk);
+		}
+
+		T result = std::move(identity);
+		for (auto& partial : partials)
+		{
+			result = reduce(std::move(result), std::move(partial));
+		}
+		return result;
+	}
+
+	template<typename... Fs>
+	void ThreadManager::parallel_invoke(Fs&&... fs)
+	{
+		auto chunk = [&](std::size_t index)
+		{
+			std::size_t position = 0;
+			((position++ == index ? static_cast<void>(std::invoke(fs)) : static_cast<void>(0)), ...);
+		};
+
+		if constexpr (sizeof...(Fs) == 1)
+		{
+			chunk(0);
+		}
+		else if constexpr (sizeof...(Fs) > 1)
+		{
+			run_parallel_region(sizeof...(Fs), chunk);
+		}
+	}
+
 } // namespace RoboTact::Core
 
 #endif // THREAD_MANAGER_HPP
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include "thread_scheduling.hpp"
+#include "core/utils/logger/logger.hpp"
+#include "core/utils/service_locator/service_locator.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#if defined(ROBOTACT_PLATFORM_LINUX)
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/mman.h>
+#endif
+
+namespace RoboTact::Core
+{
+#if defined(ROBOTACT_PLATFORM_LINUX)
+	namespace
+	{
+		const char* privilege_hint(int error) noexcept
+		{
+			return error == EPERM
+				? "(insufficient privileges: needs CAP_SYS_NICE or an rtprio/memlock limit)"
+				: "";
+		}
+
+		bool apply_affinity(std::thread& thread, const ThreadSchedulingConfig& config,
+							std::size_t group_index, std::string_view label)
+		{
+			cpu_set_t set;
+			CPU_ZERO(&set);
+
+			auto add_cpu = [&set](int cpu) {
+				if (cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+			};
+
+			if (config.spread)
+			{
+				add_cpu(config.cpus[group_index % config.cpus.size()]);
+			}
+			else
+			{
+				for (int cpu : config.cpus) add_cpu(cpu);
+			}
+
+			const int error = pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+			if (error != 0)
+			{
+				LOG_WARNING("Could not pin thread", label, "to requested CPUs:",
+							std::strerror(error), privilege_hint(error));
+				return false;
+			}
+			return true;
+		}
+
+		bool apply_policy(std::thread& thread, const ThreadSchedulingConfig& config,
+						  std::string_view label)
+		{
+			const int policy = config.policy == SchedulingPolicy::FIFO ? SCHED_FIFO : SCHED_RR;
+
+			sched_param param{};
+			param.sched_priority = std::clamp(config.priority,
+											  sched_get_priority_min(policy),
+											  sched_get_priority_max(policy));
+
+			const int error = pthread_setschedparam(thread.native_handle(), policy, &param);
+			if (error != 0)
+			{
+				LOG_WARNING("Could not set real-time scheduling for thread", label, ":",
+							std::strerror(error), privilege_hint(error),
+							"- keeping default scheduling");
+				return false;
+			}
+			return true;
+		}
+	}
+
+	bool apply_thread_scheduling(std::thread& thread, const ThreadSchedulingConfig& config,
+								 std::size_t group_index, std::string_view label)
+	{
+	    bool applied = true;
+
+	    if (!config.cpus.empty())
+	    {
+	        applied = apply_affinity(thread, config, group_index, label) && applied;
+	    }
+
+	    if (config.policy != SchedulingPolicy::DEFAULT)
+	    {
+	        applied = apply_policy(thread, config, label) && applied;
+	    }
+	    return applied;
+	}
+
+	bool lock_process_memory()
+	{
+	    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+	    {
+	        const int error = errno;
+	        LOG_WARNING("mlockall failed:", std::strerror(error), privilege_hint(error),
+	                    "- memory may be paged out");
+	        return false;
+	    }
+	    return true;
+	}
+#else
+	bool apply_thread_scheduling(std::thread&, const ThreadSchedulingConfig& config,
+								 std::size_t, std::string_view label)
+	{
+	    if (config.is_default()) return true;
+
+	    LOG_WARNING("Thread affinity/real-time scheduling is not supported on this platform; thread",
+	                label, "keeps default scheduling");
+	    return false;
+	}
+
+	bool lock_process_memory()
+	{
+	    LOG_WARNING("Memory locking is not supported on this platform");
+	    return false;
+	}
+#endif
+
+} // namespace RoboTact::Core
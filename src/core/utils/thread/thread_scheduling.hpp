@@ -0,0 +1,71 @@
+#ifndef THREAD_SCHEDULING_HPP
+#define THREAD_SCHEDULING_HPP
+
+/**
+ * @brief OS-level placement and scheduling of managed threads
+ *
+ * Features:
+ * - CPU pinning (pthread_setaffinity_np)
+ * - SCHED_FIFO / SCHED_RR real-time priorities
+ * - Process-wide memory locking (mlockall)
+ *
+ * Everything here is best effort: missing privileges or an unsupported
+ * platform produce a logged warning and leave the thread on the default
+ * scheduler instead of failing.
+ */
+
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace RoboTact::Core
+{
+
+/**
+ * @enum SchedulingPolicy
+ * @brief Kernel scheduling class of a thread
+ */
+enum class SchedulingPolicy
+{
+    DEFAULT,        ///< Leave the OS default (SCHED_OTHER)
+    FIFO,           ///< SCHED_FIFO real-time
+    ROUND_ROBIN     ///< SCHED_RR real-time
+};
+
+/**
+ * @struct ThreadSchedulingConfig
+ * @brief Placement and priority requested for a thread (or group of threads)
+ */
+struct ThreadSchedulingConfig
+{
+    std::vector<int> cpus;                              ///< Allowed CPUs (empty = no pinning)
+    bool spread                 {false};                ///< Pin thread i of a group to cpus[i % n] only
+    SchedulingPolicy policy     {SchedulingPolicy::DEFAULT};
+    int priority                {0};                    ///< Real-time priority (FIFO/RR only)
+
+    [[nodiscard]] bool is_default() const noexcept
+    {
+        return cpus.empty() && policy == SchedulingPolicy::DEFAULT;
+    }
+};
+
+/**
+ * @brief Applies a scheduling configuration to a running thread
+ * @param thread Target thread
+ * @param config Requested placement/priority
+ * @param group_index Position of the thread in its group (used by `spread`)
+ * @param label Thread name used in warnings
+ * @return true if every requested setting was applied
+ */
+bool apply_thread_scheduling(std::thread& thread, const ThreadSchedulingConfig& config,
+                             std::size_t group_index, std::string_view label);
+
+/**
+ * @brief Locks current and future pages of the process into RAM
+ * @return true on success (warning logged otherwise)
+ */
+bool lock_process_memory();
+
+} // namespace RoboTact::Core
+
+#endif // THREAD_SCHEDULING_HPP
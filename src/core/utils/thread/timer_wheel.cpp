@@ -0,0 +1,139 @@
+#include "timer_wheel.hpp"
+
+#include <algorithm>
+
+namespace RoboTact::Core
+{
+	TimerWheel::TimerWheel(std::chrono::microseconds resolution, std::size_t slot_count)
+		: m_resolution(std::chrono::duration_cast<Clock::duration>(resolution)),
+		  m_origin(Clock::now()),
+		  m_slots(std::max<std::size_t>(1, slot_count))
+	{
+	}
+
+	TimerWheel::~TimerWheel() { stop(); }
+
+	bool TimerWheel::schedule(Clock::time_point deadline, TaskFunction callback, TaskFunction on_cancel)
+	{
+	    {
+	        std::lock_guard<std::mutex> lock(m_mutex);
+	        if (m_stop) return false;
+
+	        if (!m_thread.joinable())
+	        {
+	            m_current_tick = tick_of(Clock::now());
+	            m_thread = std::thread(&TimerWheel::run, this);
+	        }
+
+	        const std::uint64_t due_tick = std::max(tick_of(deadline), m_current_tick);
+	        m_slots[due_tick % m_slots.size()].push_back(Entry{ due_tick, std::move(callback), std::move(on_cancel) });
+	        ++m_pending;
+	    }
+	    m_cv.notify_one();
+	    return true;
+	}
+
+	void TimerWheel::stop()
+	{
+	    {
+	        std::lock_guard<std::mutex> lock(m_mutex);
+	        m_stop = true;
+	    }
+	    m_cv.notify_all();
+
+	    if (m_thread.joinable()) m_thread.join();
+
+	    std::vector<TaskFunction> cancelled;
+	    {
+	        std::lock_guard<std::mutex> lock(m_mutex);
+	        for (auto& slot : m_slots)
+	        {
+	            for (auto& entry : slot)
+	            {
+	                if (entry.on_cancel) cancelled.push_back(std::move(entry.on_cancel));
+	            }
+	            slot.clear();
+	        }
+	        m_pending = 0;
+	    }
+
+	    // Outside the lock: a cancel callback may try to schedule again
+	    for (auto& on_cancel : cancelled) on_cancel();
+	}
+
+	std::size_t TimerWheel::pending() const
+	{
+	    std::lock_guard<std::mutex> lock(m_mutex);
+	    return m_pending;
+	}
+
+	std::uint64_t TimerWheel::tick_of(Clock::time_point time) const noexcept
+	{
+	    if (time <= m_origin) return 0;
+	    // Round up: a timer must never fire before its deadline
+	    return static_cast<std::uint64_t>((time - m_origin + m_resolution - Clock::duration(1)) / m_resolution);
+	}
+
+	TimerWheel::Clock::time_point TimerWheel::time_of(std::uint64_t tick) const noexcept
+	{
+	    return m_origin + m_resolution * static_cast<Clock::rep>(tick);
+	}
+
+	void TimerWheel::collect_due(std::uint64_t up_to_tick)
+	{
+	    // After a long idle period one lap over the wheel visits every slot
+	    const std::uint64_t last = std::min(up_to_tick, m_current_tick + m_slots.size() - 1);
+
+	    for (std::uint64_t tick = m_current_tick; tick <= last; ++tick)
+	    {
+	        auto& slot = m_slots[tick % m_slots.size()];
+	        auto due = std::partition(slot.begin(), slot.end(),
+	            [up_to_tick](const Entry& entry) { return entry.due_tick > up_to_tick; });
+
+	        for (auto it = due; it != slot.end(); ++it)
+	        {
+	            m_ready.push_back(std::move(it->callback));
+	        }
+	        m_pending -= static_cast<std::size_t>(slot.end() - due);
+	        slot.erase(due, slot.end());
+	    }
+	    m_current_tick = up_to_tick + 1;
+	}
+
+	void TimerWheel::run()
+	{
+	    std::unique_lock<std::mutex> lock(m_mutex);
+	    while (!m_stop)
+	    {
+	        if (m_pending == 0)
+	        {
+	            m_cv.wait(lock, [this] { return m_stop || m_pending > 0; });
+	            continue;
+	        }
+
+	        const std::uint64_t now_tick = tick_of(Clock::now());
+	        if (now_tick >= m_current_tick)
+	        {
+	            collect_due(now_tick);
+	        }
+
+	        if (!m_ready.empty())
+	        {
+	            std::vector<TaskFunction> ready;
+	            ready.swap(m_ready);
+
+	            lock.unlock();
+	            for (auto& callback : ready) callback();
+	            ready.clear();
+	            lock.lock();
+
+	            // Hand the (now empty) buffer back to keep its capacity
+	            if (m_ready.empty()) m_ready.swap(ready);
+	            continue;
+	        }
+
+	        m_cv.wait_until(lock, time_of(m_current_tick));
+	    }
+	}
+
+} // namespace RoboTact::Core
@@ -0,0 +1,93 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include "task_function.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RoboTact::Core
+{
+
+/**
+ * @class TimerWheel
+ * @brief Hashed timing wheel firing callbacks at (or just after) deadlines
+ *
+ * Used for timed coroutine resumption: callbacks run on the wheel's own
+ * thread and are expected to be tiny (typically a ThreadManager::post).
+ * The thread is started on first use and sleeps indefinitely while no
+ * timer is pending, so an idle wheel costs nothing.
+ *
+ * Deadlines are rounded up to the tick resolution; a callback never
+ * fires early. Timers still pending at stop() run their cancel
+ * callback instead, so waiters (e.g. sleeping coroutines) are released.
+ */
+class TimerWheel
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * @param resolution Tick length
+	 * @param slot_count Number of wheel slots (deadlines further than
+	 *        resolution * slot_count away simply wrap around)
+	 */
+	explicit TimerWheel(std::chrono::microseconds resolution = std::chrono::milliseconds(1),
+						std::size_t slot_count = 512);
+	~TimerWheel();
+
+	TimerWheel(const TimerWheel&) = delete;
+	TimerWheel& operator=(const TimerWheel&) = delete;
+
+	/**
+	 * @brief Registers a callback to run once `deadline` has passed
+	 * @param on_cancel Optional; run by stop() if the timer has not fired
+	 * @return False (and neither callback runs) once stop() was called
+	 */
+	bool schedule(Clock::time_point deadline, TaskFunction callback, TaskFunction on_cancel = {});
+
+	/**
+	 * @brief Stops the wheel thread and runs the cancel callbacks of
+	 *        pending timers on the calling thread
+	 */
+	void stop();
+
+	/**
+	 * @brief Number of callbacks waiting for their deadline
+	 */
+	[[nodiscard]] std::size_t pending() const;
+
+private:
+	struct Entry
+	{
+		std::uint64_t due_tick;
+		TaskFunction callback;
+		TaskFunction on_cancel;
+	};
+
+	std::uint64_t tick_of(Clock::time_point time) const noexcept;
+	Clock::time_point time_of(std::uint64_t tick) const noexcept;
+	void collect_due(std::uint64_t up_to_tick);
+	void run();
+
+	const Clock::duration m_resolution;
+	const Clock::time_point m_origin;
+
+	std::vector<std::vector<Entry>> m_slots;
+	std::vector<TaskFunction> m_ready;
+	std::uint64_t m_current_tick 			{0};
+	std::size_t m_pending 					{0};
+
+	mutable std::mutex m_mutex;
+	std::condition_variable m_cv;
+	std::thread m_thread;
+	bool m_stop 							{false};
+};
+
+} // namespace RoboTact::Core
+
+#endif // TIMER_WHEEL_HPP
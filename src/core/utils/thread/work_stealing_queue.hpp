@@ -0,0 +1,130 @@
+#ifndef WORK_STEALING_QUEUE_HPP
+#define WORK_STEALING_QUEUE_HPP
+
+#include <vector>
+#include <mutex>
+#include <cstddef>
+
+namespace RoboTact::Core
+{
+
+/**
+ * @class WorkStealingQueue
+ * @brief Per-worker task deque used by ThreadManager
+ *
+ * The owning worker pushes and pops at the back (LIFO, cache-warm),
+ * other workers steal from the front (FIFO, oldest work first).
+ * Each deque has its own lock, so contention is limited to the owner
+ * and the occasional thief instead of the whole pool.
+ *
+ * Items live in a power-of-two ring that only ever grows, so steady-state
+ * push/pop never touches the allocator.
+ *
+ * @tparam T Default-constructible, movable task type
+ */
+template<typename T>
+class alignas(64) WorkStealingQueue
+{
+public:
+	static constexpr std::size_t INITIAL_CAPACITY = 64;
+
+	WorkStealingQueue() : m_ring(INITIAL_CAPACITY) {}
+
+	WorkStealingQueue(const WorkStealingQueue&) = delete;
+	WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+
+	/**
+	 * @brief Pushes an item at the owner end
+	 * @param item Task to enqueue
+	 */
+	void push(T&& item)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_count == m_ring.size()) grow();
+
+		m_ring[(m_head + m_count) & (m_ring.size() - 1)] = std::move(item);
+		++m_count;
+	}
+
+	/**
+	 * @brief Pushes `count` items at the owner end under a single lock
+	 * @param make Callable invoked as make(i) for i in [0, count), returning T
+	 */
+	template<typename Make>
+	void push_bulk(std::size_t count, Make&& make)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		while (m_count + count > m_ring.size()) grow();
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			m_ring[(m_head + m_count) & (m_ring.size() - 1)] = make(i);
+			++m_count;
+		}
+	}
+
+	/**
+	 * @brief Pops the most recently pushed item (owner side)
+	 * @param out Receives the item on success
+	 * @return true if an item was popped
+	 */
+	bool try_pop(T& out)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_count == 0) return false;
+
+		--m_count;
+		T& slot = m_ring[(m_head + m_count) & (m_ring.size() - 1)];
+		out = std::move(slot);
+		slot = T{};
+		return true;
+	}
+
+	/**
+	 * @brief Steals the oldest item (thief side)
+	 * @param out Receives the item on success
+	 * @return true if an item was stolen
+	 */
+	bool try_steal(T& out)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_count == 0) return false;
+
+		T& slot = m_ring[m_head];
+		out = std::move(slot);
+		slot = T{};
+		m_head = (m_head + 1) & (m_ring.size() - 1);
+		--m_count;
+		return true;
+	}
+
+	/**
+	 * @brief Number of queued items (snapshot)
+	 */
+	[[nodiscard]] std::size_t size() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_count;
+	}
+
+private:
+	void grow()
+	{
+		std::vector<T> ring(m_ring.size() * 2);
+		for (std::size_t i = 0; i < m_count; ++i)
+		{
+			ring[i] = std::move(m_ring[(m_head + i) & (m_ring.size() - 1)]);
+		}
+		m_ring.swap(ring);
+		m_head = 0;
+	}
+
+	std::vector<T> m_ring;
+	std::size_t m_head 		{0};
+	std::size_t m_count 	{0};
+	mutable std::mutex m_mutex;
+};
+
+} // namespace RoboTact::Core
+
+#endif // WORK_STEALING_QUEUE_HPP
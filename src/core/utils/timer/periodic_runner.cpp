@@ -0,0 +1,106 @@
+#include "periodic_runner.hpp"
+#include "core/utils/thread/cpu_relax.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace RoboTact::Core
+{
+
+PeriodicRunner::PeriodicRunner(PeriodicConfig config)
+    : m_config(config)
+{
+}
+
+void PeriodicRunner::run(const std::function<bool()>& keep_running, const std::function<void()>& tick)
+{
+    const Clock::duration period = std::chrono::duration_cast<Clock::duration>(m_config.period);
+    Clock::time_point deadline = Clock::now();
+
+    while (keep_running())
+    {
+        const Clock::time_point scheduled = deadline;
+        wait_until(scheduled);
+
+        const auto start = Clock::now();
+        tick();
+        const auto end = Clock::now();
+
+        deadline += period;
+
+        bool overrun = false;
+        std::uint64_t skipped = 0;
+        if (end > deadline)
+        {
+            overrun = true;
+            const auto behind = static_cast<std::uint64_t>((end - deadline) / period);
+
+            if (m_config.overrun_policy == OverrunPolicy::SKIP)
+            {
+                // Realign to the next grid point still in the future
+                skipped = behind + 1;
+            }
+            else if (behind > m_config.max_catch_up)
+            {
+                skipped = behind - m_config.max_catch_up;
+            }
+            deadline += period * static_cast<Clock::rep>(skipped);
+        }
+
+        record(start - scheduled, end - start, overrun, skipped);
+    }
+}
+
+void PeriodicRunner::wait_until(Clock::time_point deadline) const
+{
+    if (m_config.spin_window.count() > 0)
+    {
+        std::this_thread::sleep_until(deadline - m_config.spin_window);
+        // Busy-wait: yield() could hand the core away past the deadline
+        while (Clock::now() < deadline)
+        {
+            cpu_relax();
+        }
+    }
+    else
+    {
+        std::this_thread::sleep_until(deadline);
+    }
+}
+
+void PeriodicRunner::record(Clock::duration jitter, Clock::duration work, bool overrun, std::uint64_t skipped)
+{
+    using Micro = std::chrono::duration<double, std::micro>;
+    const double jitter_us = std::max(0.0, Micro(jitter).count());
+    const double work_us = Micro(work).count();
+
+    std::lock_guard<std::mutex> lock(m_stats_mutex);
+    ++m_stats.ticks;
+    m_stats.overruns += overrun ? 1 : 0;
+    m_stats.skipped += skipped;
+
+    m_total_jitter_us += jitter_us;
+    m_total_work_us += work_us;
+
+    m_stats.last_jitter_us = jitter_us;
+    m_stats.max_jitter_us = std::max(m_stats.max_jitter_us, jitter_us);
+    m_stats.max_work_us = std::max(m_stats.max_work_us, work_us);
+    m_stats.mean_jitter_us = m_total_jitter_us / static_cast<double>(m_stats.ticks);
+    m_stats.mean_work_us = m_total_work_us / static_cast<double>(m_stats.ticks);
+}
+
+PeriodicStats PeriodicRunner::get_stats() const
+{
+    std::lock_guard<std::mutex> lock(m_stats_mutex);
+    return m_stats;
+}
+
+void PeriodicRunner::reset_stats()
+{
+    std::lock_guard<std::mutex> lock(m_stats_mutex);
+    m_stats = {};
+    m_total_jitter_us = 0.0;
+    m_total_work_us = 0.0;
+}
+
+} // namespace RoboTact::Core
@@ -0,0 +1,108 @@
+#ifndef PERIODIC_RUNNER_HPP
+#define PERIODIC_RUNNER_HPP
+
+/**
+ * @brief Fixed-rate loop driver for simulation/IO style threads
+ *
+ * Features:
+ * - Absolute deadlines (sleep_until), so the rate does not drift with work time
+ * - Optional short spin before each deadline for lower wake-up jitter
+ * - Overrun detection with skip or catch-up policies
+ * - Jitter/overrun statistics queryable from any thread
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+namespace RoboTact::Core
+{
+
+/**
+ * @enum OverrunPolicy
+ * @brief What to do when a tick finishes after the next deadline
+ */
+enum class OverrunPolicy
+{
+    SKIP,       ///< Drop the missed ticks and realign to the period grid
+    CATCH_UP    ///< Run missed ticks back-to-back (bounded by max_catch_up)
+};
+
+/**
+ * @struct PeriodicConfig
+ * @brief Timing parameters of a PeriodicRunner
+ */
+struct PeriodicConfig
+{
+    std::chrono::nanoseconds period         {std::chrono::milliseconds(16)};
+    std::chrono::nanoseconds spin_window    {0};    ///< Busy-wait this long before a deadline
+    OverrunPolicy overrun_policy            {OverrunPolicy::SKIP};
+    std::uint32_t max_catch_up              {4};    ///< Backlog limit for CATCH_UP (in periods)
+};
+
+/**
+ * @struct PeriodicStats
+ * @brief Snapshot of a PeriodicRunner's timing behaviour
+ */
+struct PeriodicStats
+{
+    std::uint64_t ticks             {0};
+    std::uint64_t overruns          {0};    ///< Ticks that ended past the next deadline
+    std::uint64_t skipped           {0};    ///< Deadlines dropped by the overrun policy
+    double last_jitter_us           {0.0};  ///< Wake-up lateness of the last tick
+    double mean_jitter_us           {0.0};
+    double max_jitter_us            {0.0};
+    double mean_work_us             {0.0};  ///< Time spent inside the tick callback
+    double max_work_us              {0.0};
+};
+
+/**
+ * @class PeriodicRunner
+ * @brief Runs a callback at a fixed period against absolute deadlines
+ */
+class PeriodicRunner
+{
+public:
+    explicit PeriodicRunner(PeriodicConfig config);
+
+    PeriodicRunner(const PeriodicRunner&) = delete;
+    PeriodicRunner& operator=(const PeriodicRunner&) = delete;
+
+    /**
+     * @brief Ticks until keep_running() returns false
+     * @param keep_running Checked once per period, before waiting
+     * @param tick Work executed at every deadline
+     * @throws Whatever tick throws (the runner can be restarted)
+     */
+    void run(const std::function<bool()>& keep_running, const std::function<void()>& tick);
+
+    /**
+     * @copydoc PeriodicConfig
+     */
+    [[nodiscard]] const PeriodicConfig& get_config() const noexcept { return m_config; }
+
+    /**
+     * @brief Thread-safe snapshot of the timing statistics
+     */
+    [[nodiscard]] PeriodicStats get_stats() const;
+
+    void reset_stats();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void wait_until(Clock::time_point deadline) const;
+    void record(Clock::duration jitter, Clock::duration work, bool overrun, std::uint64_t skipped);
+
+    const PeriodicConfig m_config;
+
+    mutable std::mutex m_stats_mutex;
+    PeriodicStats m_stats;
+    double m_total_jitter_us    {0.0};
+    double m_total_work_us      {0.0};
+};
+
+} // namespace RoboTact::Core
+
+#endif // PERIODIC_RUNNER_HPP
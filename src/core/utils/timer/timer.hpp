@@ -134,6 +134,39 @@ private:
     mutable std::mutex m_mutex;   
 };
 
+/**
+ * @class FixedStepTimer
+ * @brief ITimer advancing by a fixed step on every update()
+ * 
+ * Used in deterministic runs, where frame time must not depend on the
+ * wall clock. Not thread-safe: it is only driven by the stepping thread.
+ */
+class FixedStepTimer final : public ITimer
+{
+public:
+    explicit FixedStepTimer(double step = 1.0 / 60.0) noexcept : m_step(step) {}
+
+    void reset() override { m_delta_time = m_elapsed_time = m_accumulated_time = 0.0; }
+
+    void update() override
+    {
+        m_delta_time = m_step;
+        m_elapsed_time += m_step;
+        m_accumulated_time += m_step;
+    }
+
+    void consume_accumulated_time(double time) override { m_accumulated_time -= time; }
+    double get_delta_time() const noexcept override { return m_delta_time; }
+    double get_elapsed_time() const noexcept override { return m_elapsed_time; }
+    double get_accumulated_time() const noexcept override { return m_accumulated_time; }
+
+private:
+    const double m_step;
+    double m_delta_time         {0.0};
+    double m_elapsed_time       {0.0};
+    double m_accumulated_time   {0.0};
+};
+
 /**
  * @class MockTimer
  * @brief Test implementation of ITimer
@@ -0,0 +1,78 @@
+/**
+ * @brief Coroutines sleeping on the TimerWheel across stop_all()
+ *
+ * A coroutine suspended in sleep_for() must be resumed by stop_all() with
+ * TaskCancelled instead of waiting out its deadline or leaking, and
+ * co_awaits on a stopped pool must fail right away.
+ */
+
+#include "test_support.hpp"
+
+#include "core/utils/thread/coroutine.hpp"
+#include "core/utils/thread/thread_manager.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+using namespace RoboTact;
+using namespace std::chrono_literals;
+
+namespace
+{
+	Core::AsyncTask<int> sleeper(Core::ThreadManager& thread_manager, std::chrono::milliseconds duration,
+								 std::atomic<bool>& woke)
+	{
+		co_await Core::sleep_for(thread_manager, duration);
+		woke = true;
+		co_return 42;
+	}
+
+	template<typename Future>
+	bool throws_cancelled(Future& future)
+	{
+		try {
+			future.get();
+		} catch (const Core::TaskCancelled&) {
+			return true;
+		}
+		return false;
+	}
+}
+
+int main()
+{
+	Test::use_null_logger();
+
+	Core::ThreadManager::PoolConfig config;
+	config.worker_count = 2;
+	config.pin_workers = false;
+	Core::ThreadManager thread_manager(config);
+
+	// A short sleep completes normally
+	std::atomic<bool> short_woke{false};
+	auto short_sleep = Core::spawn(thread_manager, sleeper(thread_manager, 5ms, short_woke));
+	CHECK(short_sleep.get() == 42);
+	CHECK(short_woke);
+
+	// A long sleep is cut short by the stop
+	std::atomic<bool> long_woke{false};
+	auto long_sleep = Core::spawn(thread_manager, sleeper(thread_manager, std::chrono::milliseconds(60'000), long_woke));
+	std::this_thread::sleep_for(10ms);
+
+	const auto stop_started = std::chrono::steady_clock::now();
+	thread_manager.stop_all();
+	CHECK(throws_cancelled(long_sleep));
+	CHECK(!long_woke);
+	CHECK(std::chrono::steady_clock::now() - stop_started < 10s);
+
+	// Nothing can be scheduled any more
+	std::atomic<bool> late_woke{false};
+	auto late = Core::spawn(thread_manager, sleeper(thread_manager, 1ms, late_woke));
+	CHECK(throws_cancelled(late));
+	CHECK(!late_woke);
+
+	std::puts("coroutine_shutdown_test: ok");
+	return 0;
+}
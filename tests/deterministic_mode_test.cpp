@@ -0,0 +1,77 @@
+/**
+ * @brief ExecutionMode::DETERMINISTIC ordering
+ *
+ * Periodic loops, posted tasks and idle work all run on the stepping
+ * thread against the virtual clock, so a scenario produces the same
+ * interleaving on every run and on every machine.
+ */
+
+#include "test_support.hpp"
+
+#include "core/utils/thread/thread_manager.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+using namespace RoboTact;
+using namespace std::chrono_literals;
+
+namespace
+{
+	std::string run_scenario()
+	{
+		Core::ThreadManager::PoolConfig config;
+		config.mode = Core::ThreadManager::ExecutionMode::DETERMINISTIC;
+		Core::ThreadManager thread_manager(config);
+		CHECK(thread_manager.worker_count() == 0);
+
+		std::string trace;
+		const auto start = thread_manager.now();
+
+		Core::PeriodicConfig simulation;
+		simulation.period = 10ms;
+		thread_manager.start_periodic_thread(Core::ThreadManager::ThreadType::SIMULATION, simulation, [&] {
+			trace += 'S';
+			thread_manager.post([&] { trace += 's'; });
+		});
+
+		Core::PeriodicConfig io;
+		io.period = 4ms;
+		thread_manager.start_periodic_thread(Core::ThreadManager::ThreadType::IO, io, [&] { trace += 'I'; });
+
+		thread_manager.post_idle([&] { trace += 'i'; });
+
+		for (int frame = 0; frame < 3; ++frame)
+		{
+			thread_manager.step_deterministic(8ms);
+			thread_manager.run_idle_tasks(0ns);
+			trace += '|';
+		}
+		CHECK(thread_manager.now() - start == 24ms);
+
+		// Tasks submitted between steps complete within the next step
+		auto result = thread_manager.submit([] { return 7; });
+		CHECK(!result.is_ready());
+		thread_manager.step_deterministic(1ms);
+		CHECK(result.is_ready() && result.get() == 7);
+
+		thread_manager.stop_all();
+		return trace;
+	}
+}
+
+int main()
+{
+	Test::use_null_logger();
+
+	const std::string first = run_scenario();
+	const std::string second = run_scenario();
+	std::printf("trace: %s\n", first.c_str());
+
+	CHECK(first == second);
+	CHECK(first == "SsIIIi|SsII|SsII|");
+
+	std::puts("deterministic_mode_test: ok");
+	return 0;
+}
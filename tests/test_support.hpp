@@ -0,0 +1,39 @@
+#ifndef TEST_SUPPORT_HPP
+#define TEST_SUPPORT_HPP
+
+/**
+ * @brief Minimal helpers shared by the tests in this directory
+ *
+ * Every test is a plain executable registered with CTest: it exits with 0
+ * when all checks pass and reports the first failed CHECK otherwise.
+ * CHECK stays active in Release builds, unlike assert().
+ */
+
+#include "core/utils/logger/logger.hpp"
+#include "core/utils/service_locator/service_locator.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+#define CHECK(condition)                                                            \
+	do {                                                                            \
+		if (!(condition)) {                                                         \
+			std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__,   \
+						 #condition);                                               \
+			std::exit(EXIT_FAILURE);                                                \
+		}                                                                           \
+	} while (0)
+
+namespace RoboTact::Test
+{
+	/**
+	 * @brief Registers a NullLogger so LOG_* calls in the code under test are silent
+	 */
+	inline void use_null_logger()
+	{
+		Core::ServiceLocator::register_service<Core::ILogger>(std::make_shared<Core::NullLogger>());
+	}
+} // namespace RoboTact::Test
+
+#endif // TEST_SUPPORT_HPP
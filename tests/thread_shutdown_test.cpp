@@ -0,0 +1,165 @@
+/**
+ * @brief ThreadManager shutdown with work still queued
+ *
+ * Bulk batches and task graphs must settle (complete or fail with
+ * TaskCancelled) on stop_all() and emergency_stop(), never leave their
+ * waiters blocked.
+ */
+
+#include "test_support.hpp"
+
+#include "core/utils/thread/task_graph.hpp"
+#include "core/utils/thread/thread_manager.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <stdexcept>
+#include <thread>
+
+using namespace RoboTact;
+using namespace std::chrono_literals;
+
+namespace
+{
+	Core::ThreadManager::PoolConfig pool(std::size_t workers)
+	{
+		Core::ThreadManager::PoolConfig config;
+		config.worker_count = workers;
+		config.pin_workers = false;
+		return config;
+	}
+
+	template<typename Wait>
+	bool throws_cancelled(Wait&& wait)
+	{
+		try {
+			wait();
+		} catch (const Core::TaskCancelled&) {
+			return true;
+		}
+		return false;
+	}
+
+	void slow_task()
+	{
+		std::this_thread::sleep_for(1ms);
+	}
+
+	void bulk_emergency_stop()
+	{
+		Core::ThreadManager thread_manager(pool(1));
+		std::atomic<int> ran{0};
+
+		auto bulk = thread_manager.enqueue_bulk(200, [&](std::size_t) { ++ran; slow_task(); });
+		std::list<int> items(50, 1);
+		auto range = thread_manager.enqueue_range(items.begin(), items.end(), [&](int) { ++ran; slow_task(); });
+
+		std::this_thread::sleep_for(10ms);
+		thread_manager.emergency_stop();
+
+		CHECK(throws_cancelled([&] { bulk.get(); }));
+		CHECK(throws_cancelled([&] { range.get(); }));
+		CHECK(bulk.is_done() && range.is_done());
+		CHECK(ran.load() < 250);
+
+		// Refused outright once stopped
+		auto late = thread_manager.enqueue_bulk(10, [&](std::size_t) { ++ran; });
+		CHECK(late.is_done());
+		CHECK(throws_cancelled([&] { late.get(); }));
+	}
+
+	void bulk_graceful_stop()
+	{
+		Core::ThreadManager thread_manager(pool(2));
+		std::atomic<int> ran{0};
+
+		auto bulk = thread_manager.enqueue_bulk(100, [&](std::size_t) { ++ran; });
+		thread_manager.stop_all();
+
+		// Queued work is drained before the workers exit
+		bulk.get();
+		CHECK(ran.load() == 100);
+	}
+
+	void graph_stop(bool emergency)
+	{
+		Core::ThreadManager thread_manager(pool(2));
+		Core::TaskGraph graph;
+		std::atomic<int> ran{0};
+
+		// A long chain with fan-out, so the run is in progress when the pool stops
+		auto previous = graph.add([&] { ++ran; });
+		for (int i = 0; i < 100; ++i)
+		{
+			auto left = previous.then([&] { ++ran; slow_task(); });
+			auto right = previous.then([&] { ++ran; slow_task(); });
+			previous = graph.add([&] { ++ran; });
+			previous.succeed(left).succeed(right);
+		}
+
+		graph.run(thread_manager);
+		std::thread stopper([&] {
+			std::this_thread::sleep_for(20ms);
+			if (emergency) thread_manager.emergency_stop();
+			else thread_manager.stop_all();
+		});
+
+		CHECK(throws_cancelled([&] { graph.wait(thread_manager); }));
+		stopper.join();
+		CHECK(!graph.is_running());
+		CHECK(static_cast<std::size_t>(ran.load()) < graph.size());
+
+		// Runs on a stopped pool fail at once
+		CHECK(throws_cancelled([&] { graph.run_and_wait(thread_manager); }));
+	}
+
+	void graph_wait_from_worker()
+	{
+		// One worker waiting on a graph whose nodes land in its own deque
+		Core::ThreadManager thread_manager(pool(1));
+		Core::TaskGraph graph;
+		std::atomic<int> ran{0};
+
+		auto root = graph.add([&] { ++ran; });
+		auto sink = graph.add([&] { ++ran; });
+		for (int i = 0; i < 16; ++i)
+		{
+			root.then([&] { ++ran; }).precede(sink);
+		}
+
+		thread_manager.submit([&] { graph.run_and_wait(thread_manager); }).get();
+		CHECK(ran.load() == 18);
+	}
+
+	void graph_rejects_foreign_nodes()
+	{
+		Core::TaskGraph first;
+		Core::TaskGraph second;
+		auto a = first.add([] {});
+		auto b = second.add([] {});
+
+		bool threw = false;
+		try {
+			first.precede(a, b);
+		} catch (const std::invalid_argument&) {
+			threw = true;
+		}
+		CHECK(threw);
+	}
+}
+
+int main()
+{
+	Test::use_null_logger();
+
+	bulk_emergency_stop();
+	bulk_graceful_stop();
+	graph_stop(false);
+	graph_stop(true);
+	graph_wait_from_worker();
+	graph_rejects_foreign_nodes();
+
+	std::puts("thread_shutdown_test: ok");
+	return 0;
+}
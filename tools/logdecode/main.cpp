@@ -0,0 +1,56 @@
+/**
+ * @brief Converts a RoboTact binary log back into the text log format
+ *
+ * Usage: robotact-logdecode <binary-log> [output-file]
+ *
+ * Writes to stdout when no output file is given.
+ */
+
+#include "core/utils/logger/binary_log.hpp"
+
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iostream>
+
+using namespace RoboTact;
+
+int main(int argc, char** argv)
+{
+	if (argc < 2 || argc > 3)
+	{
+		std::fprintf(stderr, "Usage: %s <binary-log> [output-file]\n", argv[0]);
+		return 2;
+	}
+
+	std::ifstream input(argv[1], std::ios::in | std::ios::binary);
+	if (!input.is_open())
+	{
+		std::fprintf(stderr, "Cannot open %s\n", argv[1]);
+		return 1;
+	}
+
+	std::ofstream file_output;
+	if (argc == 3)
+	{
+		file_output.open(argv[2], std::ios::out | std::ios::trunc);
+		if (!file_output.is_open())
+		{
+			std::fprintf(stderr, "Cannot create %s\n", argv[2]);
+			return 1;
+		}
+	}
+	std::ostream& output = file_output.is_open() ? static_cast<std::ostream&>(file_output) : std::cout;
+
+	try
+	{
+		const std::size_t count = Core::BinaryLog::decode(input, output);
+		std::fprintf(stderr, "Decoded %zu messages\n", count);
+	}
+	catch (const std::exception& e)
+	{
+		std::fprintf(stderr, "%s: %s\n", argv[1], e.what());
+		return 1;
+	}
+	return 0;
+}